@@ -8,3 +8,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogALS, Log, All);
+
+DECLARE_STATS_GROUP(TEXT("ALS"), STATGROUP_ALS, STATCAT_Advanced);
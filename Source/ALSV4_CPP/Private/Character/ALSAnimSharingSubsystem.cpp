@@ -0,0 +1,277 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Character/ALSAnimSharingSubsystem.h"
+
+#include "ALSV4_CPP.h"
+#include "Character/ALSBaseCharacter.h"
+#include "Character/Animation/ALSCharacterAnimInstance.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "HAL/IConsoleManager.h"
+#include "IAnimationBudgetAllocator.h"
+#include "SkeletalMeshComponentBudgeted.h"
+
+DECLARE_CYCLE_STAT(TEXT("Anim Sharing Update"), STAT_ALS_AnimSharingUpdate, STATGROUP_ALS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Anim Sharing Leaders"), STAT_ALS_AnimSharingLeaders, STATGROUP_ALS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Anim Sharing Followers"), STAT_ALS_AnimSharingFollowers, STATGROUP_ALS);
+
+namespace ALSAnimSharing
+{
+	TAutoConsoleVariable<int32> CVarEnable(
+		TEXT("als.AnimSharing.Enable"),
+		1,
+		TEXT("Share poses between low significance ALS characters which registered for anim sharing."),
+		ECVF_Default);
+
+	TAutoConsoleVariable<float> CVarMaxFollowerSignificance(
+		TEXT("als.AnimSharing.MaxFollowerSignificance"),
+		0.4f,
+		TEXT("Characters with a higher anim significance always evaluate their own pose."),
+		ECVF_Default);
+
+	TAutoConsoleVariable<float> CVarSpeedBandWidth(
+		TEXT("als.AnimSharing.SpeedBandWidth"),
+		75.0f,
+		TEXT("Characters share a pose only when their speeds fall in the same band of this width."),
+		ECVF_Default);
+
+	TAutoConsoleVariable<int32> CVarMaxFollowersPerLeader(
+		TEXT("als.AnimSharing.MaxFollowersPerLeader"),
+		32,
+		TEXT("Larger buckets are split between several leaders."),
+		ECVF_Default);
+
+	TAutoConsoleVariable<float> CVarUpdateInterval(
+		TEXT("als.AnimSharing.UpdateInterval"),
+		0.25f,
+		TEXT("Seconds between two bucket assignments."),
+		ECVF_Default);
+}
+
+void UALSAnimSharingSubsystem::Deinitialize()
+{
+	for (FSharedCharacter& Entry : Characters)
+	{
+		StopFollowing(Entry);
+	}
+
+	Characters.Reset();
+	Super::Deinitialize();
+}
+
+void UALSAnimSharingSubsystem::Tick(float DeltaTime)
+{
+	TimeUntilUpdate -= DeltaTime;
+	if (TimeUntilUpdate <= 0.0f)
+	{
+		TimeUntilUpdate = ALSAnimSharing::CVarUpdateInterval.GetValueOnGameThread();
+		UpdateSharing();
+	}
+}
+
+bool UALSAnimSharingSubsystem::IsTickable() const
+{
+	return Characters.Num() > 0 && !IsTemplate();
+}
+
+TStatId UALSAnimSharingSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UALSAnimSharingSubsystem, STATGROUP_Tickables);
+}
+
+void UALSAnimSharingSubsystem::RegisterCharacter(AALSBaseCharacter* Character)
+{
+	if (Character && !Characters.ContainsByPredicate([Character](const FSharedCharacter& Entry)
+	{
+		return Entry.Character == Character;
+	}))
+	{
+		FSharedCharacter& Entry = Characters.AddDefaulted_GetRef();
+		Entry.Character = Character;
+	}
+}
+
+void UALSAnimSharingSubsystem::UnregisterCharacter(AALSBaseCharacter* Character)
+{
+	const int32 Index = Characters.IndexOfByPredicate([Character](const FSharedCharacter& Entry)
+	{
+		return Entry.Character == Character;
+	});
+
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	StopFollowing(Characters[Index]);
+	Characters.RemoveAtSwap(Index);
+
+	// Followers of a removed leader animate themselves until the next update assigns them a new one
+	for (FSharedCharacter& Entry : Characters)
+	{
+		if (Entry.Leader == Character)
+		{
+			StopFollowing(Entry);
+		}
+	}
+}
+
+bool UALSAnimSharingSubsystem::IsFollower(const AALSBaseCharacter* Character) const
+{
+	const FSharedCharacter* Entry = Characters.FindByPredicate([Character](const FSharedCharacter& Other)
+	{
+		return Other.Character == Character;
+	});
+
+	return Entry && Entry->Leader.IsValid();
+}
+
+UALSAnimSharingSubsystem::FBucketKey UALSAnimSharingSubsystem::MakeBucketKey(const AALSBaseCharacter& Character)
+{
+	FBucketKey Key;
+	Key.Mesh = Character.GetMesh()->SkeletalMesh;
+	Key.MovementState = Character.GetMovementState();
+	Key.Gait = Character.GetGait();
+	Key.Stance = Character.GetStance();
+	Key.OverlayState = Character.GetOverlayState();
+	Key.SpeedBand = FMath::FloorToInt(
+		Character.GetSpeed() / FMath::Max(ALSAnimSharing::CVarSpeedBandWidth.GetValueOnGameThread(), 1.0f));
+	return Key;
+}
+
+void UALSAnimSharingSubsystem::UpdateSharing()
+{
+	SCOPE_CYCLE_COUNTER(STAT_ALS_AnimSharingUpdate);
+
+	// Characters destroyed without unregistering
+	Characters.RemoveAllSwap([](const FSharedCharacter& Entry)
+	{
+		return !Entry.Character.IsValid();
+	});
+
+	const bool bEnabled = ALSAnimSharing::CVarEnable.GetValueOnGameThread() != 0;
+	const float MaxFollowerSignificance = ALSAnimSharing::CVarMaxFollowerSignificance.GetValueOnGameThread();
+	const int32 MaxFollowersPerLeader = FMath::Max(ALSAnimSharing::CVarMaxFollowersPerLeader.GetValueOnGameThread(),
+	                                               1);
+
+	TMap<FBucketKey, TArray<int32, TInlineAllocator<16>>> Buckets;
+	for (int32 Index = 0; Index < Characters.Num(); ++Index)
+	{
+		FSharedCharacter& Entry = Characters[Index];
+		AALSBaseCharacter* Character = Entry.Character.Get();
+		Entry.Significance = Character->GetAnimSignificance();
+
+		// Ragdolls and significant characters always evaluate their own pose
+		if (!bEnabled || Entry.Significance > MaxFollowerSignificance ||
+			Character->GetMovementState() == EALSMovementState::Ragdoll || !Character->GetMesh()->SkeletalMesh)
+		{
+			StopFollowing(Entry);
+			Entry.bIsLeader = false;
+			continue;
+		}
+
+		Buckets.FindOrAdd(MakeBucketKey(*Character)).Add(Index);
+	}
+
+	uint32 NumLeaders = 0;
+	uint32 NumFollowers = 0;
+	for (auto& Bucket : Buckets)
+	{
+		TArray<int32, TInlineAllocator<16>>& Members = Bucket.Value;
+
+		// Current leaders go first, so followers don't switch poses on every update
+		Members.Sort([this](int32 A, int32 B)
+		{
+			if (Characters[A].bIsLeader != Characters[B].bIsLeader)
+			{
+				return Characters[A].bIsLeader;
+			}
+			return Characters[A].Significance > Characters[B].Significance;
+		});
+
+		AALSBaseCharacter* Leader = nullptr;
+		int32 NumLeaderFollowers = 0;
+		for (int32 Index : Members)
+		{
+			FSharedCharacter& Entry = Characters[Index];
+			if (!Leader || NumLeaderFollowers >= MaxFollowersPerLeader)
+			{
+				StopFollowing(Entry);
+				Entry.bIsLeader = true;
+				Leader = Entry.Character.Get();
+				NumLeaderFollowers = 0;
+				++NumLeaders;
+			}
+			else
+			{
+				Follow(Entry, Leader);
+				++NumLeaderFollowers;
+				++NumFollowers;
+			}
+		}
+	}
+
+	SET_DWORD_STAT(STAT_ALS_AnimSharingLeaders, NumLeaders);
+	SET_DWORD_STAT(STAT_ALS_AnimSharingFollowers, NumFollowers);
+}
+
+void UALSAnimSharingSubsystem::Follow(FSharedCharacter& Entry, AALSBaseCharacter* Leader)
+{
+	Entry.bIsLeader = false;
+	if (Entry.Leader == Leader)
+	{
+		return;
+	}
+
+	AALSBaseCharacter* Character = Entry.Character.Get();
+	USkeletalMeshComponent* Mesh = Character->GetMesh();
+	Mesh->SetMasterPoseComponent(Leader->GetMesh());
+
+	// The budget allocator enables the ticks of the meshes it manages again, it must not manage a follower
+	USkeletalMeshComponentBudgeted* BudgetedMesh = Cast<USkeletalMeshComponentBudgeted>(Mesh);
+	IAnimationBudgetAllocator* BudgetAllocator = IAnimationBudgetAllocator::Get(GetWorld());
+	if (BudgetedMesh && BudgetAllocator && BudgetedMesh->GetHandle() != INDEX_NONE)
+	{
+		BudgetAllocator->UnregisterComponent(BudgetedMesh);
+		Entry.bLeftBudgetAllocator = true;
+	}
+	Mesh->SetComponentTickEnabled(false);
+
+	// Gameplay reads curves through the cache, values of the last own evaluation must not keep being applied
+	if (UALSCharacterAnimInstance* AnimInstance = Character->GetMainAnimInstance())
+	{
+		AnimInstance->ResetCachedCurves();
+	}
+
+	Entry.Leader = Leader;
+}
+
+void UALSAnimSharingSubsystem::StopFollowing(FSharedCharacter& Entry)
+{
+	if (!Entry.Leader.IsValid() && Entry.Leader.IsExplicitlyNull())
+	{
+		return;
+	}
+
+	Entry.Leader.Reset();
+	if (AALSBaseCharacter* Character = Entry.Character.Get())
+	{
+		USkeletalMeshComponent* Mesh = Character->GetMesh();
+		Mesh->SetMasterPoseComponent(nullptr);
+		Mesh->SetComponentTickEnabled(true);
+
+		USkeletalMeshComponentBudgeted* BudgetedMesh = Cast<USkeletalMeshComponentBudgeted>(Mesh);
+		IAnimationBudgetAllocator* BudgetAllocator = IAnimationBudgetAllocator::Get(GetWorld());
+		if (Entry.bLeftBudgetAllocator && BudgetedMesh && BudgetAllocator)
+		{
+			BudgetAllocator->RegisterComponent(BudgetedMesh);
+			BudgetAllocator->UpdateComponentTickPrerequsites(BudgetedMesh);
+		}
+	}
+	Entry.bLeftBudgetAllocator = false;
+}
@@ -9,27 +9,41 @@
 #include "Character/ALSBaseCharacter.h"
 
 
+#include "Character/ALSAnimSharingSubsystem.h"
+#include "Character/ALSSignificanceSubsystem.h"
+#include "Character/ALSTickSubsystem.h"
+#include "Character/Animation/ALSAnimKernelSubsystem.h"
 #include "Character/Animation/ALSCharacterAnimInstance.h"
-#include "Character/Animation/ALSPlayerCameraBehavior.h"
 #include "Library/ALSMathLibrary.h"
+#include "Components/ALSMantleComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/TimelineComponent.h"
 #include "Curves/CurveVector.h"
 #include "Curves/CurveFloat.h"
 #include "Character/ALSCharacterMovementComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Kismet/GameplayStatics.h"
-#include "TimerManager.h"
 #include "Net/UnrealNetwork.h"
+#include "PhysicsEngine/BodyInstance.h"
+#include "IAnimationBudgetAllocator.h"
+#include "SkeletalMeshComponentBudgeted.h"
 
 AALSBaseCharacter::AALSBaseCharacter(const FObjectInitializer& ObjectInitializer)
-	: Super(ObjectInitializer.SetDefaultSubobjectClass<UALSCharacterMovementComponent>(CharacterMovementComponentName))
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<UALSCharacterMovementComponent>(CharacterMovementComponentName)
+	                         .SetDefaultSubobjectClass<USkeletalMeshComponentBudgeted>(MeshComponentName))
 {
 	PrimaryActorTick.bCanEverTick = true;
 	bUseControllerRotationYaw = 0;
 	bReplicates = true;
 	SetReplicatingMovement(true);
+
+	TickBuckets.Add({0.7f, 0.0f});
+	TickBuckets.Add({0.4f, 0.05f});
+	TickBuckets.Add({0.1f, 0.1f});
+	TickBuckets.Add({0.0f, 0.25f});
 }
 
 void AALSBaseCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
@@ -102,19 +116,25 @@ void AALSBaseCharacter::BeginPlay()
 	// Make sure the mesh and animbp update after the CharacterBP to ensure it gets the most recent values.
 	GetMesh()->AddTickPrerequisiteActor(this);
 
+	// Characters in the batch keep the same order towards their movement component and mesh
+	if (bUseBatchedTick)
+	{
+		GetWorld()->GetSubsystem<UALSTickSubsystem>()->RegisterCharacter(this);
+	}
+
+	// The budget allocator ticks registered meshes itself, it has to pick up the prerequisite added above
+	USkeletalMeshComponentBudgeted* BudgetedMesh = Cast<USkeletalMeshComponentBudgeted>(GetMesh());
+	if (BudgetedMesh && BudgetedMesh->GetHandle() != INDEX_NONE)
+	{
+		if (IAnimationBudgetAllocator* BudgetAllocator = IAnimationBudgetAllocator::Get(GetWorld()))
+		{
+			BudgetAllocator->UpdateComponentTickPrerequsites(BudgetedMesh);
+		}
+	}
+
 	// Set the Movement Model
 	SetMovementModel();
 
-	// Once, force set variables in anim bp. This ensures anim instance & character starts synchronized
-	FALSAnimCharacterInformation& AnimData = MainAnimInstance->GetCharacterInformationMutable();
-	MainAnimInstance->Gait = DesiredGait;
-	MainAnimInstance->Stance = DesiredStance;
-	MainAnimInstance->RotationMode = DesiredRotationMode;
-	AnimData.ViewMode = ViewMode;
-	MainAnimInstance->OverlayState = OverlayState;
-	AnimData.PrevMovementState = PrevMovementState;
-	MainAnimInstance->MovementState = MovementState;
-
 	// Update states to use the initial desired values.
 	SetGait(DesiredGait);
 	SetStance(DesiredStance);
@@ -140,6 +160,66 @@ void AALSBaseCharacter::BeginPlay()
 	{
 		MainAnimInstance->SetRootMotionMode(ERootMotionMode::IgnoreRootMotion);
 	}
+
+	// Poses are only shared for rendering, dedicated servers evaluate every character
+	if (bUseAnimSharing && !IsNetMode(NM_DedicatedServer))
+	{
+		GetWorld()->GetSubsystem<UALSAnimSharingSubsystem>()->RegisterCharacter(this);
+	}
+
+	if (bUseBatchedAnimKernels)
+	{
+		GetWorld()->GetSubsystem<UALSAnimKernelSubsystem>()->RegisterCharacter(this);
+	}
+
+	if (bUseSignificanceTickBuckets)
+	{
+		GetWorld()->GetSubsystem<UALSSignificanceSubsystem>()->RegisterCharacter(this);
+	}
+
+	// Anim instance & camera behavior start synchronized with the initial states
+	PublishFrameState();
+}
+
+void AALSBaseCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UALSTickSubsystem* TickSubsystem = GetWorld()->GetSubsystem<UALSTickSubsystem>();
+	if (bUseBatchedTick && TickSubsystem)
+	{
+		TickSubsystem->UnregisterCharacter(this);
+	}
+
+	UALSAnimSharingSubsystem* AnimSharing = GetWorld()->GetSubsystem<UALSAnimSharingSubsystem>();
+	if (bUseAnimSharing && AnimSharing)
+	{
+		AnimSharing->UnregisterCharacter(this);
+	}
+
+	UALSAnimKernelSubsystem* AnimKernels = GetWorld()->GetSubsystem<UALSAnimKernelSubsystem>();
+	if (bUseBatchedAnimKernels && AnimKernels)
+	{
+		AnimKernels->UnregisterCharacter(this);
+	}
+
+	UALSSignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UALSSignificanceSubsystem>();
+	if (bUseSignificanceTickBuckets && Significance)
+	{
+		Significance->UnregisterCharacter(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AALSBaseCharacter::OnDeadline(FALSDeadline& Deadline)
+{
+	if (&Deadline == &OnLandedFrictionResetDeadline)
+	{
+		OnLandFrictionReset();
+	}
+	else if (&Deadline == &OnCameraModeSwapDeadline)
+	{
+		OnSwitchCameraMode();
+	}
 }
 
 void AALSBaseCharacter::PreInitializeComponents()
@@ -154,20 +234,29 @@ void AALSBaseCharacter::PreInitializeComponents()
 		       TEXT("%s doesn't have a valid animation instance assigned. That's not allowed"),
 		       *GetName());
 	}
+
+	// Mesh registers itself on begin play, significance is reported by the character instead of the allocator
+	if (USkeletalMeshComponentBudgeted* BudgetedMesh = Cast<USkeletalMeshComponentBudgeted>(GetMesh()))
+	{
+		BudgetedMesh->SetAutoRegisterWithBudgetAllocator(bUseAnimationBudgetAllocator);
+		BudgetedMesh->SetAutoCalculateSignificance(false);
+	}
 }
 
 void AALSBaseCharacter::SetAimYawRate(float NewAimYawRate)
 {
 	AimYawRate = NewAimYawRate;
-	MainAnimInstance->GetCharacterInformationMutable().AimYawRate = AimYawRate;
 }
 
 void AALSBaseCharacter::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	// Set required values
-	SetEssentialValues(DeltaTime);
+	// Set required values, unless the tick subsystem computed them in parallel already
+	if (EssentialValuesFrame != GFrameCounter)
+	{
+		SetEssentialValues(DeltaTime);
+	}
 
 	if (MovementState == EALSMovementState::Grounded)
 	{
@@ -183,9 +272,85 @@ void AALSBaseCharacter::Tick(float DeltaTime)
 		RagdollUpdate(DeltaTime);
 	}
 
+	if (bUseAnimationBudgetAllocator)
+	{
+		UpdateAnimationBudget();
+	}
+
+	if (IsServerAnimMode())
+	{
+		UpdateServerPoseEvaluation();
+	}
+
 	// Cache values
 	PreviousVelocity = GetVelocity();
 	PreviousAimYaw = AimingRotation.Yaw;
+
+	// Movement component ticks before the character, so the state already includes this frame's movement
+	PublishFrameState();
+}
+
+void AALSBaseCharacter::PublishFrameState()
+{
+	FALSCharacterFrameState& State = FrameState.GetBack();
+	State.Acceleration = Acceleration;
+	State.Speed = Speed;
+	State.MovementInputAmount = MovementInputAmount;
+	State.AimYawRate = AimYawRate;
+	State.bIsMoving = bIsMoving;
+	State.bHasMovementInput = bHasMovementInput;
+	State.bRightShoulder = bRightShoulder;
+	State.MovementState = MovementState;
+	State.PrevMovementState = PrevMovementState;
+	State.MovementAction = MovementAction;
+	State.RotationMode = RotationMode;
+	State.Gait = Gait;
+	State.Stance = Stance;
+	State.ViewMode = ViewMode;
+	State.OverlayState = OverlayState;
+	FrameState.Publish();
+}
+
+void AALSBaseCharacter::UpdateAnimationBudget()
+{
+	USkeletalMeshComponentBudgeted* BudgetedMesh = Cast<USkeletalMeshComponentBudgeted>(GetMesh());
+	if (!BudgetedMesh || BudgetedMesh->GetHandle() == INDEX_NONE || !MainAnimInstance)
+	{
+		return;
+	}
+
+	IAnimationBudgetAllocator* BudgetAllocator = IAnimationBudgetAllocator::Get(GetWorld());
+	if (!BudgetAllocator)
+	{
+		return;
+	}
+
+	// Character rotation is driven by these curves, a skipped mesh tick would keep applying their stale values
+	const FALSGameplayCurves Curves = MainAnimInstance->GetGameplayCurves();
+	const bool bNeverSkip = Curves.RotationAmount != 0.0f || Curves.YawOffset != 0.0f;
+
+	BudgetAllocator->SetComponentSignificance(BudgetedMesh, GetAnimSignificance(), bNeverSkip);
+}
+
+void AALSBaseCharacter::UpdateServerPoseEvaluation()
+{
+	// Montages, root motion and notifies keep ticking. The pose is evaluated only while grounded without an action,
+	// where UpdateGroundedRotation reads the curves, and during ragdoll the bodies are followed instead of the bones.
+	const bool bEvaluatePose = MovementState == EALSMovementState::Grounded &&
+		MovementAction == EALSMovementAction::None;
+	using ETickOption = EVisibilityBasedAnimTickOption;
+	const ETickOption TickOption = bEvaluatePose ? ETickOption::AlwaysTickPoseAndRefreshBones : ETickOption::AlwaysTickPose;
+	if (GetMesh()->VisibilityBasedAnimTickOption == TickOption)
+	{
+		return;
+	}
+
+	GetMesh()->VisibilityBasedAnimTickOption = TickOption;
+	if (!bEvaluatePose && MainAnimInstance)
+	{
+		// Curves of the last evaluation would otherwise be read again before the next one
+		MainAnimInstance->ResetCachedCurves();
+	}
 }
 
 void AALSBaseCharacter::RagdollStart()
@@ -199,12 +364,12 @@ void AALSBaseCharacter::RagdollStart()
 	and if the host is a dedicated server, change character mesh optimisation option to avoid z-location bug*/
 	MyCharacterMovementComponent->bIgnoreClientMovementErrorChecksAndCorrection = 1;
 
-	if (UKismetSystemLibrary::IsDedicatedServer(GetWorld()))
+	if (UKismetSystemLibrary::IsDedicatedServer(GetWorld()) && !IsServerAnimMode())
 	{
 		DefVisBasedTickOp = GetMesh()->VisibilityBasedAnimTickOption;
 		GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
 	}
-	TargetRagdollLocation = GetMesh()->GetSocketLocation(FName(TEXT("Pelvis")));
+	TargetRagdollLocation = GetBoneCache().GetLocation(*GetMesh(), EALSBone::Pelvis);
 	ServerRagdollPull = 0;
 
 	// Step 1: Clear the Character Movement Mode and set the Movement State to Ragdoll
@@ -228,7 +393,7 @@ void AALSBaseCharacter::RagdollEnd()
 	/** Re-enable Replicate Movement and if the host is a dedicated server set mesh visibility based anim
 	tick option back to default*/
 
-	if (UKismetSystemLibrary::IsDedicatedServer(GetWorld()))
+	if (UKismetSystemLibrary::IsDedicatedServer(GetWorld()) && !IsServerAnimMode())
 	{
 		GetMesh()->VisibilityBasedAnimTickOption = DefVisBasedTickOp;
 	}
@@ -281,10 +446,14 @@ void AALSBaseCharacter::SetMovementState(const EALSMovementState NewState)
 	{
 		PrevMovementState = MovementState;
 		MovementState = NewState;
-		FALSAnimCharacterInformation& AnimData = MainAnimInstance->GetCharacterInformationMutable();
-		AnimData.PrevMovementState = PrevMovementState;
-		MainAnimInstance->MovementState = MovementState;
 		OnMovementStateChanged(PrevMovementState);
+		PublishFrameState();
+
+		// Don't wait for the next significance update to tick every frame
+		if (bUseSignificanceTickBuckets && RequiresFullTickRate())
+		{
+			SetTickBucket(0);
+		}
 	}
 }
 
@@ -294,8 +463,8 @@ void AALSBaseCharacter::SetMovementAction(const EALSMovementAction NewAction)
 	{
 		const EALSMovementAction Prev = MovementAction;
 		MovementAction = NewAction;
-		MainAnimInstance->MovementAction = MovementAction;
 		OnMovementActionChanged(Prev);
+		PublishFrameState();
 	}
 }
 
@@ -306,6 +475,7 @@ void AALSBaseCharacter::SetStance(const EALSStance NewStance)
 		const EALSStance Prev = Stance;
 		Stance = NewStance;
 		OnStanceChanged(Prev);
+		PublishFrameState();
 	}
 }
 
@@ -316,6 +486,7 @@ void AALSBaseCharacter::SetGait(const EALSGait NewGait)
 		const EALSGait Prev = Gait;
 		Gait = NewGait;
 		OnGaitChanged(Prev);
+		PublishFrameState();
 	}
 }
 
@@ -369,6 +540,7 @@ void AALSBaseCharacter::SetRotationMode(const EALSRotationMode NewRotationMode)
 		const EALSRotationMode Prev = RotationMode;
 		RotationMode = NewRotationMode;
 		OnRotationModeChanged(Prev);
+		PublishFrameState();
 
 		if (GetLocalRole() == ROLE_AutonomousProxy)
 		{
@@ -389,6 +561,7 @@ void AALSBaseCharacter::SetViewMode(const EALSViewMode NewViewMode)
 		const EALSViewMode Prev = ViewMode;
 		ViewMode = NewViewMode;
 		OnViewModeChanged(Prev);
+		PublishFrameState();
 
 		if (GetLocalRole() == ROLE_AutonomousProxy)
 		{
@@ -409,6 +582,7 @@ void AALSBaseCharacter::SetOverlayState(const EALSOverlayState NewState)
 		const EALSOverlayState Prev = OverlayState;
 		OverlayState = NewState;
 		OnOverlayStateChanged(Prev);
+		PublishFrameState();
 
 		if (GetLocalRole() == ROLE_AutonomousProxy)
 		{
@@ -440,8 +614,7 @@ void AALSBaseCharacter::EventOnLanded()
 		GetCharacterMovement()->BrakingFrictionFactor = bHasMovementInput ? 0.5f : 3.0f;
 
 		// After 0.5 secs, reset braking friction factor to zero
-		GetWorldTimerManager().SetTimer(OnLandedFrictionResetTimer, this,
-		                                &AALSBaseCharacter::OnLandFrictionReset, 0.5f, false);
+		UALSDeadlineSubsystem::Schedule(this, OnLandedFrictionResetDeadline, 0.5f);
 	}
 }
 
@@ -521,7 +694,6 @@ void AALSBaseCharacter::SetMovementModel()
 void AALSBaseCharacter::SetHasMovementInput(bool bNewHasMovementInput)
 {
 	bHasMovementInput = bNewHasMovementInput;
-	MainAnimInstance->GetCharacterInformationMutable().bHasMovementInput = bHasMovementInput;
 }
 
 FALSMovementSettings AALSBaseCharacter::GetTargetMovementSettings() const
@@ -597,7 +769,6 @@ bool AALSBaseCharacter::CanSprint() const
 void AALSBaseCharacter::SetIsMoving(bool bNewIsMoving)
 {
 	bIsMoving = bNewIsMoving;
-	MainAnimInstance->GetCharacterInformationMutable().bIsMoving = bIsMoving;
 }
 
 FVector AALSBaseCharacter::GetMovementInput() const
@@ -608,13 +779,128 @@ FVector AALSBaseCharacter::GetMovementInput() const
 void AALSBaseCharacter::SetMovementInputAmount(float NewMovementInputAmount)
 {
 	MovementInputAmount = NewMovementInputAmount;
-	MainAnimInstance->GetCharacterInformationMutable().MovementInputAmount = MovementInputAmount;
 }
 
 void AALSBaseCharacter::SetSpeed(float NewSpeed)
 {
 	Speed = NewSpeed;
-	MainAnimInstance->GetCharacterInformationMutable().Speed = Speed;
+}
+
+const FALSBoneCache& AALSBaseCharacter::GetBoneCache() const
+{
+	BoneCache.Update(*GetMesh());
+	return BoneCache;
+}
+
+float AALSBaseCharacter::GetAnimSignificance() const
+{
+	if (IsNetMode(NM_DedicatedServer) || IsLocallyControlled())
+	{
+		return 1.0f;
+	}
+
+	if (!GetMesh()->WasRecentlyRendered(0.5f))
+	{
+		return 0.0f;
+	}
+
+	float MinDistSquared = FMath::Square(SignificanceMaxDistance);
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		if (PC && PC->IsLocalController() && PC->PlayerCameraManager)
+		{
+			MinDistSquared = FMath::Min(MinDistSquared, FVector::DistSquared(
+				                            PC->PlayerCameraManager->GetCameraLocation(), GetActorLocation()));
+		}
+	}
+
+	return FMath::GetMappedRangeValueClamped({0.0f, SignificanceMaxDistance}, {1.0f, 0.1f},
+	                                         FMath::Sqrt(MinDistSquared));
+}
+
+float AALSBaseCharacter::GetTickSignificance(const FTransform& Viewpoint) const
+{
+	if (IsPlayerControlled())
+	{
+		return 1.0f;
+	}
+
+	// Only clients and standalone games render for the viewpoint, a listen server also ticks for remote players
+	const ENetMode NetMode = GetNetMode();
+	if ((NetMode == NM_Client || NetMode == NM_Standalone) && !GetMesh()->WasRecentlyRendered(0.5f))
+	{
+		return 0.0f;
+	}
+
+	return FMath::GetMappedRangeValueClamped({0.0f, SignificanceMaxDistance}, {1.0f, 0.0f},
+	                                         FVector::Dist(Viewpoint.GetLocation(), GetActorLocation()));
+}
+
+int32 AALSBaseCharacter::FindTickBucket(float Significance) const
+{
+	for (int32 Index = 0; Index < TickBuckets.Num(); ++Index)
+	{
+		if (Significance >= TickBuckets[Index].MinSignificance)
+		{
+			return Index;
+		}
+	}
+
+	return FMath::Max(0, TickBuckets.Num() - 1);
+}
+
+void AALSBaseCharacter::SetTickBucket(int32 NewTickBucket)
+{
+	if (NewTickBucket == TickBucket)
+	{
+		return;
+	}
+
+	TickBucket = NewTickBucket;
+
+	// Ticks with an interval receive the time elapsed since their previous tick, also in the batched tick
+	const float TickInterval = TickBuckets.IsValidIndex(TickBucket) ? TickBuckets[TickBucket].TickInterval : 0.0f;
+	SetActorTickInterval(TickInterval);
+
+	TInlineComponentArray<UALSMantleComponent*> MantleComponents(this);
+	for (UALSMantleComponent* MantleComponent : MantleComponents)
+	{
+		MantleComponent->SetComponentTickInterval(TickInterval);
+	}
+}
+
+bool AALSBaseCharacter::RequiresFullTickRate() const
+{
+	return MovementState == EALSMovementState::Ragdoll || MovementState == EALSMovementState::Mantling;
+}
+
+void AALSBaseCharacter::AddUpdatePrerequisite(FTickFunction& Dependent)
+{
+	UALSTickSubsystem* TickSubsystem = GetWorld()->GetSubsystem<UALSTickSubsystem>();
+	if (bUseBatchedTick && TickSubsystem && TickSubsystem->IsRegistered(this))
+	{
+		Dependent.AddPrerequisite(TickSubsystem, TickSubsystem->GetTickFunction());
+	}
+	else
+	{
+		Dependent.AddPrerequisite(this, PrimaryActorTick);
+	}
+}
+
+void AALSBaseCharacter::RemoveUpdatePrerequisite(FTickFunction& Dependent)
+{
+	UALSTickSubsystem* TickSubsystem = GetWorld()->GetSubsystem<UALSTickSubsystem>();
+	if (TickSubsystem)
+	{
+		Dependent.RemovePrerequisite(TickSubsystem, TickSubsystem->GetTickFunction());
+	}
+	Dependent.RemovePrerequisite(this, PrimaryActorTick);
+}
+
+bool AALSBaseCharacter::IsServerAnimMode() const
+{
+	return bUseServerAnimMode && IsNetMode(NM_DedicatedServer);
 }
 
 float AALSBaseCharacter::GetAnimCurveValue(FName CurveName) const
@@ -627,13 +913,15 @@ float AALSBaseCharacter::GetAnimCurveValue(FName CurveName) const
 	return 0.0f;
 }
 
+FALSGameplayCurves AALSBaseCharacter::GetGameplayCurves() const
+{
+	return MainAnimInstance ? MainAnimInstance->GetGameplayCurves() : FALSGameplayCurves();
+}
+
 void AALSBaseCharacter::SetRightShoulder(bool bNewRightShoulder)
 {
 	bRightShoulder = bNewRightShoulder;
-	if (CameraBehavior)
-	{
-		CameraBehavior->bRightShoulder = bRightShoulder;
-	}
+	PublishFrameState();
 }
 
 ECollisionChannel AALSBaseCharacter::GetThirdPersonTraceParams(FVector& TraceOrigin, float& TraceRadius)
@@ -650,7 +938,7 @@ FTransform AALSBaseCharacter::GetThirdPersonPivotTarget()
 
 FVector AALSBaseCharacter::GetFirstPersonCameraTarget()
 {
-	return GetMesh()->GetSocketLocation(FName(TEXT("FP_Camera")));
+	return GetBoneCache().GetLocation(*GetMesh(), EALSBone::FPCamera);
 }
 
 void AALSBaseCharacter::GetCameraParameters(float& TPFOVOut, float& FPFOVOut, bool& bRightShoulderOut) const
@@ -665,13 +953,13 @@ void AALSBaseCharacter::SetAcceleration(const FVector& NewAcceleration)
 	Acceleration = (NewAcceleration != FVector::ZeroVector || IsLocallyControlled())
 		               ? NewAcceleration
 		               : Acceleration / 2;
-	MainAnimInstance->GetCharacterInformationMutable().Acceleration = Acceleration;
 }
 
 void AALSBaseCharacter::RagdollUpdate(float DeltaTime)
 {
 	// Set the Last Ragdoll Velocity.
-	const FVector NewRagdollVel = GetMesh()->GetPhysicsLinearVelocity(FName(TEXT("root")));
+	const FBodyInstance* RootBody = GetBoneCache().GetBodyInstance(*GetMesh(), EALSBone::Root);
+	const FVector NewRagdollVel = RootBody ? RootBody->GetUnrealWorldVelocity() : FVector::ZeroVector;
 	LastRagdollVelocity = (NewRagdollVel != FVector::ZeroVector || IsLocallyControlled())
 		                      ? NewRagdollVel
 		                      : LastRagdollVelocity / 2;
@@ -692,10 +980,11 @@ void AALSBaseCharacter::RagdollUpdate(float DeltaTime)
 
 void AALSBaseCharacter::SetActorLocationDuringRagdoll(float DeltaTime)
 {
+	const FALSBoneCache& Bones = GetBoneCache();
 	if (IsLocallyControlled())
 	{
-		// Set the pelvis as the target location.
-		TargetRagdollLocation = GetMesh()->GetSocketLocation(FName(TEXT("Pelvis")));
+		// Set the pelvis as the target location. Bodies are read directly, the pose may not be evaluated.
+		TargetRagdollLocation = Bones.GetSimulatedTransform(*GetMesh(), EALSBone::Pelvis).GetLocation();
 		if (!HasAuthority())
 		{
 			Server_SetMeshLocationDuringRagdoll(TargetRagdollLocation);
@@ -703,7 +992,7 @@ void AALSBaseCharacter::SetActorLocationDuringRagdoll(float DeltaTime)
 	}
 
 	// Determine wether the ragdoll is facing up or down and set the target rotation accordingly.
-	const FRotator PelvisRot = GetMesh()->GetSocketRotation(FName(TEXT("Pelvis")));
+	const FRotator PelvisRot = Bones.GetSimulatedTransform(*GetMesh(), EALSBone::Pelvis).Rotator();
 
 	bRagdollFaceUp = PelvisRot.Roll < 0.0f;
 
@@ -731,12 +1020,15 @@ void AALSBaseCharacter::SetActorLocationDuringRagdoll(float DeltaTime)
 	}
 	if (!IsLocallyControlled())
 	{
-		ServerRagdollPull = FMath::FInterpTo(ServerRagdollPull, 750, DeltaTime, 0.6);
+		ServerRagdollPull = UALSMathLibrary::FInterpToSubstepped(ServerRagdollPull, 750.0f, DeltaTime, 0.6f);
 		float RagdollSpeed = FVector(LastRagdollVelocity.X, LastRagdollVelocity.Y, 0).Size();
-		FName RagdollSocketPullName = RagdollSpeed > 300 ? FName(TEXT("spine_03")) : FName(TEXT("pelvis"));
-		GetMesh()->AddForce(
-			(TargetRagdollLocation - GetMesh()->GetSocketLocation(RagdollSocketPullName)) * ServerRagdollPull,
-			RagdollSocketPullName, true);
+		const EALSBone RagdollPullBone = RagdollSpeed > 300 ? EALSBone::Spine03 : EALSBone::Pelvis;
+		if (FBodyInstance* PullBody = Bones.GetBodyInstance(*GetMesh(), RagdollPullBone))
+		{
+			PullBody->AddForce(
+				(TargetRagdollLocation - PullBody->GetUnrealWorldTransform().GetLocation()) * ServerRagdollPull,
+				true, true);
+		}
 	}
 	SetActorLocationAndTargetRotation(bRagdollOnGround ? NewRagdollLoc : TargetRagdollLocation, TargetRagdollRotation);
 }
@@ -778,11 +1070,6 @@ void AALSBaseCharacter::OnMovementStateChanged(const EALSMovementState PreviousS
 			ReplicatedRagdollStart();
 		}
 	}
-
-	if (CameraBehavior)
-	{
-		CameraBehavior->MovementState = MovementState;
-	}
 }
 
 void AALSBaseCharacter::OnMovementActionChanged(const EALSMovementAction PreviousAction)
@@ -804,52 +1091,28 @@ void AALSBaseCharacter::OnMovementActionChanged(const EALSMovementAction Previou
 			Crouch();
 		}
 	}
-
-	if (CameraBehavior)
-	{
-		CameraBehavior->MovementAction = MovementAction;
-	}
 }
 
 void AALSBaseCharacter::OnStanceChanged(const EALSStance PreviousStance)
 {
-	MainAnimInstance->Stance = Stance;
-
-	if (CameraBehavior)
-	{
-		CameraBehavior->Stance = Stance;
-	}
 }
 
 void AALSBaseCharacter::OnRotationModeChanged(EALSRotationMode PreviousRotationMode)
 {
-	MainAnimInstance->RotationMode = RotationMode;
 	if (RotationMode == EALSRotationMode::VelocityDirection && ViewMode == EALSViewMode::FirstPerson)
 	{
 		// If the new rotation mode is Velocity Direction and the character is in First Person,
 		// set the viewmode to Third Person.
 		SetViewMode(EALSViewMode::ThirdPerson);
 	}
-
-	if (CameraBehavior)
-	{
-		CameraBehavior->SetRotationMode(RotationMode);
-	}
 }
 
 void AALSBaseCharacter::OnGaitChanged(const EALSGait PreviousGait)
 {
-	MainAnimInstance->Gait = Gait;
-
-	if (CameraBehavior)
-	{
-		CameraBehavior->Gait = Gait;
-	}
 }
 
 void AALSBaseCharacter::OnViewModeChanged(const EALSViewMode PreviousViewMode)
 {
-	MainAnimInstance->GetCharacterInformationMutable().ViewMode = ViewMode;
 	if (ViewMode == EALSViewMode::ThirdPerson)
 	{
 		if (RotationMode == EALSRotationMode::VelocityDirection || RotationMode == EALSRotationMode::LookingDirection)
@@ -863,16 +1126,10 @@ void AALSBaseCharacter::OnViewModeChanged(const EALSViewMode PreviousViewMode)
 		// If First Person, set the rotation mode to looking direction if currently in the velocity direction mode.
 		SetRotationMode(EALSRotationMode::LookingDirection);
 	}
-
-	if (CameraBehavior)
-	{
-		CameraBehavior->ViewMode = ViewMode;
-	}
 }
 
 void AALSBaseCharacter::OnOverlayStateChanged(const EALSOverlayState PreviousState)
 {
-	MainAnimInstance->OverlayState = OverlayState;
 }
 
 void AALSBaseCharacter::OnStartCrouch(float HalfHeightAdjust, float ScaledHalfHeightAdjust)
@@ -923,6 +1180,15 @@ void AALSBaseCharacter::OnLandFrictionReset()
 }
 
 void AALSBaseCharacter::SetEssentialValues(float DeltaTime)
+{
+	FALSEssentialValuesInput Input;
+	GatherEssentialValues(DeltaTime, Input);
+	FALSEssentialValuesOutput Output;
+	ComputeEssentialValues(Input, Output);
+	ApplyEssentialValues(Output);
+}
+
+void AALSBaseCharacter::GatherEssentialValues(float DeltaTime, FALSEssentialValuesInput& OutInput)
 {
 	if (GetLocalRole() != ROLE_SimulatedProxy)
 	{
@@ -938,44 +1204,70 @@ void AALSBaseCharacter::SetEssentialValues(float DeltaTime)
 			                       : EasedMaxAcceleration / 2;
 	}
 
+	OutInput.Velocity = GetVelocity();
+	OutInput.PreviousVelocity = PreviousVelocity;
+	OutInput.CurrentAcceleration = ReplicatedCurrentAcceleration;
+	OutInput.AimingRotation = AimingRotation;
+	OutInput.ControlRotation = ReplicatedControlRotation;
+	OutInput.LastVelocityRotation = LastVelocityRotation;
+	OutInput.LastMovementInputRotation = LastMovementInputRotation;
+	OutInput.DeltaTime = DeltaTime;
+	OutInput.EasedMaxAcceleration = EasedMaxAcceleration;
+	OutInput.PreviousAimYaw = PreviousAimYaw;
+}
+
+void AALSBaseCharacter::ComputeEssentialValues(const FALSEssentialValuesInput& Input,
+                                               FALSEssentialValuesOutput& OutOutput)
+{
 	// Interp AimingRotation to current control rotation for smooth character rotation movement. Decrease InterpSpeed
 	// for slower but smoother movement.
-	AimingRotation = FMath::RInterpTo(AimingRotation, ReplicatedControlRotation, DeltaTime, 30);
+	OutOutput.AimingRotation = UALSMathLibrary::RInterpToSubstepped(Input.AimingRotation, Input.ControlRotation,
+	                                                                Input.DeltaTime, 30.0f);
 
 	// These values represent how the capsule is moving as well as how it wants to move, and therefore are essential
 	// for any data driven animation system. They are also used throughout the system for various functions,
 	// so I found it is easiest to manage them all in one place.
 
-	const FVector CurrentVel = GetVelocity();
-
 	// Set the amount of Acceleration.
-	SetAcceleration((CurrentVel - PreviousVelocity) / DeltaTime);
+	OutOutput.Acceleration = (Input.Velocity - Input.PreviousVelocity) / Input.DeltaTime;
 
 	// Determine if the character is moving by getting it's speed. The Speed equals the length of the horizontal (x y)
 	// velocity, so it does not take vertical movement into account. If the character is moving, update the last
 	// velocity rotation. This value is saved because it might be useful to know the last orientation of movement
 	// even after the character has stopped.
-	SetSpeed(CurrentVel.Size2D());
-	SetIsMoving(Speed > 1.0f);
-	if (bIsMoving)
-	{
-		LastVelocityRotation = CurrentVel.ToOrientationRotator();
-	}
+	OutOutput.Speed = Input.Velocity.Size2D();
+	OutOutput.bIsMoving = OutOutput.Speed > 1.0f;
+	OutOutput.LastVelocityRotation = OutOutput.bIsMoving
+		                                 ? Input.Velocity.ToOrientationRotator()
+		                                 : Input.LastVelocityRotation;
 
 	// Determine if the character has movement input by getting its movement input amount.
 	// The Movement Input Amount is equal to the current acceleration divided by the max acceleration so that
 	// it has a range of 0-1, 1 being the maximum possible amount of input, and 0 being none.
 	// If the character has movement input, update the Last Movement Input Rotation.
-	SetMovementInputAmount(ReplicatedCurrentAcceleration.Size() / EasedMaxAcceleration);
-	SetHasMovementInput(MovementInputAmount > 0.0f);
-	if (bHasMovementInput)
-	{
-		LastMovementInputRotation = ReplicatedCurrentAcceleration.ToOrientationRotator();
-	}
+	OutOutput.MovementInputAmount = Input.CurrentAcceleration.Size() / Input.EasedMaxAcceleration;
+	OutOutput.bHasMovementInput = OutOutput.MovementInputAmount > 0.0f;
+	OutOutput.LastMovementInputRotation = OutOutput.bHasMovementInput
+		                                      ? Input.CurrentAcceleration.ToOrientationRotator()
+		                                      : Input.LastMovementInputRotation;
 
 	// Set the Aim Yaw rate by comparing the current and previous Aim Yaw value, divided by Delta Seconds.
 	// This represents the speed the camera is rotating left to right.
-	SetAimYawRate(FMath::Abs((AimingRotation.Yaw - PreviousAimYaw) / DeltaTime));
+	OutOutput.AimYawRate = FMath::Abs((OutOutput.AimingRotation.Yaw - Input.PreviousAimYaw) / Input.DeltaTime);
+}
+
+void AALSBaseCharacter::ApplyEssentialValues(const FALSEssentialValuesOutput& Output)
+{
+	AimingRotation = Output.AimingRotation;
+	SetAcceleration(Output.Acceleration);
+	SetSpeed(Output.Speed);
+	SetIsMoving(Output.bIsMoving);
+	LastVelocityRotation = Output.LastVelocityRotation;
+	SetMovementInputAmount(Output.MovementInputAmount);
+	SetHasMovementInput(Output.bHasMovementInput);
+	LastMovementInputRotation = Output.LastMovementInputRotation;
+	SetAimYawRate(Output.AimYawRate);
+	EssentialValuesFrame = GFrameCounter;
 }
 
 void AALSBaseCharacter::UpdateCharacterMovement()
@@ -1024,7 +1316,7 @@ void AALSBaseCharacter::UpdateGroundedRotation(float DeltaTime)
 				else
 				{
 					// Walking or Running..
-					const float YawOffsetCurveVal = MainAnimInstance->GetCurveValue(FName(TEXT("YawOffset")));
+					const float YawOffsetCurveVal = MainAnimInstance->GetGameplayCurves().YawOffset;
 					YawValue = AimingRotation.Yaw + YawOffsetCurveVal;
 				}
 				SmoothCharacterRotation({0.0f, YawValue, 0.0f}, 500.0f, GroundedRotationRate, DeltaTime);
@@ -1049,7 +1341,7 @@ void AALSBaseCharacter::UpdateGroundedRotation(float DeltaTime)
 			// The Rotation Amount curve defines how much rotation should be applied each frame,
 			// and is calculated for animations that are animated at 30fps.
 
-			const float RotAmountCurve = MainAnimInstance->GetCurveValue(FName(TEXT("RotationAmount")));
+			const float RotAmountCurve = MainAnimInstance->GetGameplayCurves().RotationAmount;
 
 			if (FMath::Abs(RotAmountCurve) > 0.001f)
 			{
@@ -1151,11 +1443,12 @@ EALSGait AALSBaseCharacter::GetActualGait(EALSGait AllowedGait) const
 void AALSBaseCharacter::SmoothCharacterRotation(FRotator Target, float TargetInterpSpeed, float ActorInterpSpeed,
                                                 float DeltaTime)
 {
-	// Interpolate the Target Rotation for extra smooth rotation behavior
+	// Interpolate the Target Rotation for extra smooth rotation behavior. Characters in a slower tick bucket
+	// receive the time of several frames at once, the actor rotation is sub-stepped to follow as it would have.
 	TargetRotation =
 		FMath::RInterpConstantTo(TargetRotation, Target, DeltaTime, TargetInterpSpeed);
 	SetActorRotation(
-		FMath::RInterpTo(GetActorRotation(), TargetRotation, DeltaTime, ActorInterpSpeed));
+		UALSMathLibrary::RInterpToSubstepped(GetActorRotation(), TargetRotation, DeltaTime, ActorInterpSpeed));
 }
 
 float AALSBaseCharacter::CalculateGroundedRotationRate() const
@@ -1166,7 +1459,7 @@ float AALSBaseCharacter::CalculateGroundedRotationRate() const
 
 	const float MappedSpeedVal = MyCharacterMovementComponent->GetMappedSpeed();
 	const float CurveVal =
-		MyCharacterMovementComponent->CurrentMovementSettings.RotationRateCurve->GetFloatValue(MappedSpeedVal);
+		MyCharacterMovementComponent->RotationRateCurveLUT.GetValue(MappedSpeedVal);
 	const float ClampedAimYawRate = FMath::GetMappedRangeValueClamped({0.0f, 300.0f}, {1.0f, 3.0f}, AimYawRate);
 	return CurveVal * ClampedAimYawRate;
 }
@@ -1301,8 +1594,7 @@ void AALSBaseCharacter::CameraPressedAction()
 	UWorld* World = GetWorld();
 	check(World);
 	CameraActionPressedTime = World->GetTimeSeconds();
-	GetWorldTimerManager().SetTimer(OnCameraModeSwapTimer, this,
-	                                &AALSBaseCharacter::OnSwitchCameraMode, ViewModeSwitchHoldTime, false);
+	UALSDeadlineSubsystem::Schedule(this, OnCameraModeSwapDeadline, ViewModeSwitchHoldTime);
 }
 
 void AALSBaseCharacter::CameraReleasedAction()
@@ -1319,7 +1611,7 @@ void AALSBaseCharacter::CameraReleasedAction()
 	{
 		// Switch shoulders
 		SetRightShoulder(!bRightShoulder);
-		GetWorldTimerManager().ClearTimer(OnCameraModeSwapTimer); // Prevent mode change
+		OnCameraModeSwapDeadline.Cancel(); // Prevent mode change
 	}
 }
 
@@ -1452,14 +1744,17 @@ void AALSBaseCharacter::ReplicatedRagdollEnd()
 void AALSBaseCharacter::OnRep_RotationMode(EALSRotationMode PrevRotMode)
 {
 	OnRotationModeChanged(PrevRotMode);
+	PublishFrameState();
 }
 
 void AALSBaseCharacter::OnRep_ViewMode(EALSViewMode PrevViewMode)
 {
 	OnViewModeChanged(PrevViewMode);
+	PublishFrameState();
 }
 
 void AALSBaseCharacter::OnRep_OverlayState(EALSOverlayState PrevOverlayState)
 {
 	OnOverlayStateChanged(PrevOverlayState);
+	PublishFrameState();
 }
@@ -0,0 +1,130 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Character/ALSBoneCache.h"
+
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/SkeletalMeshSocket.h"
+#include "PhysicsEngine/PhysicsAsset.h"
+
+FName FALSBoneCache::GetBoneName(EALSBone Bone)
+{
+	static const FName Names[] =
+	{
+		FName(TEXT("root")),
+		FName(TEXT("pelvis")),
+		FName(TEXT("spine_03")),
+		FName(TEXT("Head")),
+		FName(TEXT("ik_foot_l")),
+		FName(TEXT("ik_foot_r")),
+		FName(TEXT("VB foot_target_l")),
+		FName(TEXT("VB foot_target_r")),
+		FName(TEXT("FP_Camera")),
+		FName(TEXT("TP_CameraTrace_L")),
+		FName(TEXT("TP_CameraTrace_R"))
+	};
+	static_assert(UE_ARRAY_COUNT(Names) == static_cast<int32>(EALSBone::MAX), "Bone names don't match EALSBone");
+
+	return Names[static_cast<int32>(Bone)];
+}
+
+void FALSBoneCache::Update(const USkeletalMeshComponent& Component)
+{
+	const USkeletalMesh* SkeletalMesh = Component.SkeletalMesh;
+	const UPhysicsAsset* PhysicsAsset = Component.GetPhysicsAsset();
+	if (Entries.Num() > 0 && CachedSkeletalMesh.Get() == SkeletalMesh && CachedPhysicsAsset.Get() == PhysicsAsset)
+	{
+		return;
+	}
+
+	CachedSkeletalMesh = SkeletalMesh;
+	CachedPhysicsAsset = PhysicsAsset;
+
+	// Keep the sockets added by name, their indices stay valid across mesh swaps
+	const int32 NumBones = static_cast<int32>(EALSBone::MAX);
+	if (Entries.Num() < NumBones)
+	{
+		Entries.SetNum(NumBones);
+		for (int32 Index = 0; Index < NumBones; ++Index)
+		{
+			Entries[Index].Name = GetBoneName(static_cast<EALSBone>(Index));
+		}
+	}
+
+	for (FEntry& Entry : Entries)
+	{
+		ResolveEntry(Component, Entry);
+	}
+}
+
+void FALSBoneCache::Reset()
+{
+	Entries.Reset();
+	CachedSkeletalMesh.Reset();
+	CachedPhysicsAsset.Reset();
+}
+
+int32 FALSBoneCache::FindOrAddSocket(const USkeletalMeshComponent& Component, FName SocketName)
+{
+	Update(Component);
+
+	const int32 Found = Entries.IndexOfByPredicate([SocketName](const FEntry& Entry)
+	{
+		return Entry.Name == SocketName;
+	});
+	if (Found != INDEX_NONE)
+	{
+		return Found;
+	}
+
+	FEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Name = SocketName;
+	ResolveEntry(Component, Entry);
+	return Entries.Num() - 1;
+}
+
+void FALSBoneCache::ResolveEntry(const USkeletalMeshComponent& Component, FEntry& Entry) const
+{
+	const USkeletalMesh* SkeletalMesh = Component.SkeletalMesh;
+	Entry.Socket = SkeletalMesh ? SkeletalMesh->FindSocket(Entry.Name) : nullptr;
+
+	const FName BoneName = Entry.Socket ? Entry.Socket->BoneName : Entry.Name;
+	Entry.BoneIndex = Component.GetBoneIndex(BoneName);
+
+	const UPhysicsAsset* PhysicsAsset = Component.GetPhysicsAsset();
+	Entry.BodyIndex = PhysicsAsset ? PhysicsAsset->FindBodyIndex(BoneName) : INDEX_NONE;
+}
+
+FTransform FALSBoneCache::GetEntryTransform(const USkeletalMeshComponent& Component, int32 EntryIndex,
+                                            ERelativeTransformSpace Space) const
+{
+	const FTransform& ComponentTransform = Space == RTS_Component
+		                                       ? FTransform::Identity
+		                                       : Component.GetComponentTransform();
+	if (!Entries.IsValidIndex(EntryIndex) || Entries[EntryIndex].BoneIndex == INDEX_NONE)
+	{
+		return ComponentTransform;
+	}
+
+	const FEntry& Entry = Entries[EntryIndex];
+	const FTransform BoneTransform = Component.GetBoneTransform(Entry.BoneIndex, ComponentTransform);
+	return Entry.Socket ? Entry.Socket->GetSocketLocalTransform() * BoneTransform : BoneTransform;
+}
+
+FBodyInstance* FALSBoneCache::GetBodyInstance(const USkeletalMeshComponent& Component, EALSBone Bone) const
+{
+	const int32 BodyIndex = Entries[static_cast<int32>(Bone)].BodyIndex;
+	return Component.Bodies.IsValidIndex(BodyIndex) ? Component.Bodies[BodyIndex] : nullptr;
+}
+
+FTransform FALSBoneCache::GetSimulatedTransform(const USkeletalMeshComponent& Component, EALSBone Bone) const
+{
+	const FBodyInstance* Body = GetBodyInstance(Component, Bone);
+	return Body && Body->IsInstanceSimulatingPhysics() ? Body->GetUnrealWorldTransform() : GetTransform(Component, Bone);
+}
@@ -81,22 +81,24 @@ void AALSCharacter::RagdollEnd()
 
 ECollisionChannel AALSCharacter::GetThirdPersonTraceParams(FVector& TraceOrigin, float& TraceRadius)
 {
-	const FName CameraSocketName = bRightShoulder ? TEXT("TP_CameraTrace_R") : TEXT("TP_CameraTrace_L");
-	TraceOrigin = GetMesh()->GetSocketLocation(CameraSocketName);
+	const EALSBone CameraSocket = bRightShoulder ? EALSBone::TPCameraTrace_R : EALSBone::TPCameraTrace_L;
+	TraceOrigin = GetBoneCache().GetLocation(*GetMesh(), CameraSocket);
 	TraceRadius = 15.0f;
 	return ECC_Camera;
 }
 
 FTransform AALSCharacter::GetThirdPersonPivotTarget()
 {
+	const FALSBoneCache& Bones = GetBoneCache();
 	return FTransform(GetActorRotation(),
-	                  (GetMesh()->GetSocketLocation(TEXT("Head")) + GetMesh()->GetSocketLocation(TEXT("root"))) / 2.0f,
+	                  (Bones.GetLocation(*GetMesh(), EALSBone::Head) + Bones.GetLocation(*GetMesh(), EALSBone::Root)) /
+	                  2.0f,
 	                  FVector::OneVector);
 }
 
 FVector AALSCharacter::GetFirstPersonCameraTarget()
 {
-	return GetMesh()->GetSocketLocation(TEXT("FP_Camera"));
+	return GetBoneCache().GetLocation(*GetMesh(), EALSBone::FPCamera);
 }
 
 void AALSCharacter::OnOverlayStateChanged(EALSOverlayState PreviousState)
@@ -40,7 +40,7 @@ void UALSCharacterMovementComponent::PhysWalking(float deltaTime, int32 Iteratio
 	{
 		// Update the Ground Friction using the Movement Curve.
 		// This allows for fine control over movement behavior at each speed.
-		GroundFriction = CurrentMovementSettings.MovementCurve->GetVectorValue(GetMappedSpeed()).Z;
+		GroundFriction = MovementCurveLUT.GetValue(GetMappedSpeed()).Z;
 	}
 	Super::PhysWalking(deltaTime, Iterations);
 }
@@ -53,7 +53,7 @@ float UALSCharacterMovementComponent::GetMaxAcceleration() const
 	{
 		return Super::GetMaxAcceleration();
 	}
-	return CurrentMovementSettings.MovementCurve->GetVectorValue(GetMappedSpeed()).X;
+	return MovementCurveLUT.GetValue(GetMappedSpeed()).X;
 }
 
 float UALSCharacterMovementComponent::GetMaxBrakingDeceleration() const
@@ -64,7 +64,7 @@ float UALSCharacterMovementComponent::GetMaxBrakingDeceleration() const
 	{
 		return Super::GetMaxBrakingDeceleration();
 	}
-	return CurrentMovementSettings.MovementCurve->GetVectorValue(GetMappedSpeed()).Y;
+	return MovementCurveLUT.GetValue(GetMappedSpeed()).Y;
 }
 
 void UALSCharacterMovementComponent::UpdateFromCompressedFlags(uint8 Flags) // Client only
@@ -169,6 +169,8 @@ void UALSCharacterMovementComponent::SetMovementSettings(FALSMovementSettings Ne
 {
 	// Set the current movement settings from the owner
 	CurrentMovementSettings = NewMovementSettings;
+	MovementCurveLUT.Bind(CurrentMovementSettings.MovementCurve);
+	RotationRateCurveLUT.Bind(CurrentMovementSettings.RotationRateCurve);
 }
 
 void UALSCharacterMovementComponent::SetMaxWalkingSpeed(float UpdateMaxWalkSpeed)
@@ -0,0 +1,117 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Character/ALSDeadlineSubsystem.h"
+
+#include "ALSV4_CPP.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Deadline Wheel"), STAT_ALS_DeadlineWheel, STATGROUP_ALS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Deadlines Pending"), STAT_ALS_DeadlinesPending, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Deadlines Scheduled"), STAT_ALS_DeadlinesScheduled, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Deadlines Fired"), STAT_ALS_DeadlinesFired, STATGROUP_ALS);
+
+void UALSDeadlineSubsystem::Deinitialize()
+{
+	for (TArray<FEntry>& Bucket : Buckets)
+	{
+		Bucket.Empty();
+	}
+
+	DueEntries.Empty();
+	NumEntries = 0;
+	Super::Deinitialize();
+}
+
+void UALSDeadlineSubsystem::Schedule(UObject* Owner, IALSDeadlineReceiver* Receiver, FALSDeadline& Deadline,
+                                     float Delay)
+{
+	Deadline.Cancel();
+
+	UWorld* World = Owner ? Owner->GetWorld() : nullptr;
+	UALSDeadlineSubsystem* Subsystem = World ? World->GetSubsystem<UALSDeadlineSubsystem>() : nullptr;
+	if (!Subsystem || Delay <= 0.0f)
+	{
+		return;
+	}
+
+	Deadline.bActive = true;
+
+	FEntry Entry;
+	Entry.Owner = Owner;
+	Entry.Receiver = Receiver;
+	Entry.Deadline = &Deadline;
+	Entry.FireTime = World->GetTimeSeconds() + Delay;
+	Entry.Serial = Deadline.Serial;
+	Subsystem->Add(MoveTemp(Entry));
+}
+
+void UALSDeadlineSubsystem::Add(FEntry&& Entry)
+{
+	// Deadlines in buckets processed already go to the first open one, it is processed on the next tick
+	const int64 Tick = FMath::Max(static_cast<int64>(FMath::FloorToDouble(Entry.FireTime / BucketDuration)),
+	                              CompletedTick + 1);
+	Buckets[Tick % NumBuckets].Add(MoveTemp(Entry));
+	++NumEntries;
+	INC_DWORD_STAT(STAT_ALS_DeadlinesScheduled);
+}
+
+void UALSDeadlineSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ALS_DeadlineWheel);
+
+	const float Now = GetWorld()->GetTimeSeconds();
+	const int64 CurrentTick = static_cast<int64>(FMath::FloorToDouble(Now / BucketDuration));
+
+	// Process every bucket passed since the last frame, a hitch longer than a revolution visits each bucket once.
+	// The current bucket is visited again next frame, its later entries are not due yet.
+	const int64 FirstTick = FMath::Max(CompletedTick + 1, CurrentTick - NumBuckets + 1);
+	for (int64 Tick = FirstTick; Tick <= CurrentTick; ++Tick)
+	{
+		TArray<FEntry>& Bucket = Buckets[Tick % NumBuckets];
+		for (int32 Index = Bucket.Num() - 1; Index >= 0; --Index)
+		{
+			FEntry& Entry = Bucket[Index];
+			const bool bStale = !Entry.Owner.IsValid() || Entry.Deadline->Serial != Entry.Serial;
+			if (bStale || Entry.FireTime <= Now)
+			{
+				if (!bStale)
+				{
+					DueEntries.Add(MoveTemp(Entry));
+				}
+				Bucket.RemoveAtSwap(Index, 1, false);
+				--NumEntries;
+			}
+		}
+	}
+	CompletedTick = CurrentTick - 1;
+
+	// Receivers may schedule new deadlines from their callbacks
+	for (FEntry& Entry : DueEntries)
+	{
+		if (Entry.Owner.IsValid() && Entry.Deadline->Serial == Entry.Serial)
+		{
+			Entry.Deadline->bActive = false;
+			Entry.Receiver->OnDeadline(*Entry.Deadline);
+			INC_DWORD_STAT(STAT_ALS_DeadlinesFired);
+		}
+	}
+	DueEntries.Reset();
+
+	SET_DWORD_STAT(STAT_ALS_DeadlinesPending, NumEntries);
+}
+
+bool UALSDeadlineSubsystem::IsTickable() const
+{
+	return NumEntries > 0 && !IsTemplate();
+}
+
+TStatId UALSDeadlineSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UALSDeadlineSubsystem, STATGROUP_Tickables);
+}
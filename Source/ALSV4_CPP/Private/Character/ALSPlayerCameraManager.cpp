@@ -25,20 +25,22 @@ void AALSPlayerCameraManager::OnPossess(AALSBaseCharacter* NewCharacter)
 {
 	// Set "Controlled Pawn" when Player Controller Possesses new character. (called from Player Controller)
 	check(NewCharacter);
+	if (ControlledCharacter)
+	{
+		ControlledCharacter->RemoveUpdatePrerequisite(CameraBehavior->PrimaryComponentTick);
+	}
 	ControlledCharacter = NewCharacter;
 
+	// The camera behavior reads the states the character publishes at the end of its tick
+	NewCharacter->AddUpdatePrerequisite(CameraBehavior->PrimaryComponentTick);
+
 	// Update references in the Camera Behavior AnimBP.
 	UALSPlayerCameraBehavior* CastedBehv = Cast<UALSPlayerCameraBehavior>(CameraBehavior->GetAnimInstance());
 	if (CastedBehv)
 	{
 		NewCharacter->SetCameraBehavior(CastedBehv);
-		CastedBehv->MovementState = NewCharacter->GetMovementState();
-		CastedBehv->MovementAction = NewCharacter->GetMovementAction();
-		CastedBehv->bRightShoulder = NewCharacter->IsRightShoulder();
-		CastedBehv->Gait = NewCharacter->GetGait();
-		CastedBehv->SetRotationMode(NewCharacter->GetRotationMode());
-		CastedBehv->Stance = NewCharacter->GetStance();
-		CastedBehv->ViewMode = NewCharacter->GetViewMode();
+		CastedBehv->ControlledCharacter = NewCharacter;
+		CastedBehv->SetFrameState(NewCharacter->GetFrameState());
 	}
 
 	// Initial position
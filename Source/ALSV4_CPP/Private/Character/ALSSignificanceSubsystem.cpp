@@ -0,0 +1,189 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Character/ALSSignificanceSubsystem.h"
+
+#include "ALSV4_CPP.h"
+#include "Character/ALSBaseCharacter.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "SignificanceManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Significance Tick Buckets"), STAT_ALS_SignificanceTickBuckets, STATGROUP_ALS);
+
+namespace ALSSignificance
+{
+	TAutoConsoleVariable<int32> CVarUpdateManager(
+		TEXT("als.Significance.UpdateManager"),
+		1,
+		TEXT("Update the significance manager from the player views. Disable if the project updates it itself."),
+		ECVF_Default);
+
+	TAutoConsoleVariable<float> CVarUpdateInterval(
+		TEXT("als.Significance.UpdateInterval"),
+		0.25f,
+		TEXT("Seconds between two updates of the tick buckets."),
+		ECVF_Default);
+}
+
+const FName UALSSignificanceSubsystem::CharacterTag(TEXT("ALSCharacter"));
+
+void UALSSignificanceSubsystem::Deinitialize()
+{
+	if (USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld()))
+	{
+		for (const TWeakObjectPtr<AALSBaseCharacter>& Character : Characters)
+		{
+			if (Character.IsValid())
+			{
+				SignificanceManager->UnregisterObject(Character.Get());
+			}
+		}
+	}
+
+	Characters.Reset();
+	Viewers.Reset();
+	Super::Deinitialize();
+}
+
+void UALSSignificanceSubsystem::Tick(float DeltaTime)
+{
+	TimeUntilUpdate -= DeltaTime;
+	if (TimeUntilUpdate > 0.0f)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_ALS_SignificanceTickBuckets);
+	TimeUntilUpdate = ALSSignificance::CVarUpdateInterval.GetValueOnGameThread();
+
+	TArray<FTransform, TInlineAllocator<4>> Viewpoints;
+	GatherViewers(Viewpoints);
+
+	USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld());
+	if (SignificanceManager && ALSSignificance::CVarUpdateManager.GetValueOnGameThread())
+	{
+		SignificanceManager->Update(Viewpoints);
+	}
+}
+
+bool UALSSignificanceSubsystem::IsTickable() const
+{
+	return Characters.Num() > 0 && !IsTemplate();
+}
+
+TStatId UALSSignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UALSSignificanceSubsystem, STATGROUP_Tickables);
+}
+
+void UALSSignificanceSubsystem::RegisterCharacter(AALSBaseCharacter* Character)
+{
+	// The manager is not created on every net mode, see bCreateOnClient and bCreateOnServer of its config
+	USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld());
+	if (!Character || !SignificanceManager || Characters.Contains(Character))
+	{
+		return;
+	}
+
+	Characters.Add(Character);
+
+	auto SignificanceFunction = [Character](USignificanceManager::FManagedObjectInfo*, const FTransform& Viewpoint)
+	{
+		return Character->GetTickSignificance(Viewpoint);
+	};
+
+	// Tick intervals are changed on game thread, after the significance of every object is known
+	auto PostSignificanceFunction = [this, Character](USignificanceManager::FManagedObjectInfo*, float,
+	                                                  const float Significance, const bool bFinal)
+	{
+		OnSignificanceUpdated(*Character, Significance, bFinal);
+	};
+
+	SignificanceManager->RegisterObject(Character, CharacterTag, SignificanceFunction,
+	                                    USignificanceManager::EPostSignificanceType::Sequential,
+	                                    PostSignificanceFunction);
+}
+
+void UALSSignificanceSubsystem::UnregisterCharacter(AALSBaseCharacter* Character)
+{
+	if (Characters.RemoveSwap(Character) == 0)
+	{
+		return;
+	}
+
+	if (USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld()))
+	{
+		SignificanceManager->UnregisterObject(Character);
+	}
+
+	Character->SetTickBucket(0);
+}
+
+void UALSSignificanceSubsystem::GatherViewers(TArray<FTransform, TInlineAllocator<4>>& OutViewpoints)
+{
+	Viewers.Reset();
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		APlayerController* PC = It->Get();
+		if (!PC)
+		{
+			continue;
+		}
+
+		// On servers, views of remote players are the ones their connection sent last
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+		FViewer& Viewer = Viewers.AddDefaulted_GetRef();
+		Viewer.Controller = PC;
+		Viewer.Location = ViewLocation;
+		OutViewpoints.Emplace(ViewRotation, ViewLocation);
+	}
+}
+
+bool UALSSignificanceSubsystem::IsNetRelevant(const AALSBaseCharacter& Character) const
+{
+	for (const FViewer& Viewer : Viewers)
+	{
+		const APlayerController* PC = Viewer.Controller.Get();
+		if (PC && Character.IsNetRelevantFor(PC, PC->GetViewTarget(), Viewer.Location))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void UALSSignificanceSubsystem::OnSignificanceUpdated(AALSBaseCharacter& Character, float Significance,
+                                                      bool bFinal) const
+{
+	if (bFinal)
+	{
+		return;
+	}
+
+	// Pinned to the first bucket like player controlled characters, whatever their significance
+	if (Character.RequiresFullTickRate())
+	{
+		Character.SetTickBucket(0);
+		return;
+	}
+
+	// Nobody receives updates of irrelevant characters, they only keep moving for the server itself
+	const ENetMode NetMode = GetWorld()->GetNetMode();
+	if ((NetMode == NM_DedicatedServer || NetMode == NM_ListenServer) && Character.GetIsReplicated() &&
+		!Character.IsPlayerControlled() && !IsNetRelevant(Character))
+	{
+		Significance = 0.0f;
+	}
+
+	Character.SetTickBucket(Character.FindTickBucket(Significance));
+}
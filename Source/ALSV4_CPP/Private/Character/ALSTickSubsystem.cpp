@@ -0,0 +1,207 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Character/ALSTickSubsystem.h"
+
+#include "ALSV4_CPP.h"
+#include "Async/ParallelFor.h"
+#include "Components/ALSDebugComponent.h"
+#include "Components/ALSMantleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Batched Character Tick"), STAT_ALS_BatchedCharacterTick, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Batched Essential Values"), STAT_ALS_BatchedEssentialValues, STATGROUP_ALS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Batched Tick Characters"), STAT_ALS_BatchedTickCharacters, STATGROUP_ALS);
+
+namespace ALSBatchedTick
+{
+	TAutoConsoleVariable<int32> CVarParallelEssentialValues(
+		TEXT("als.BatchedTick.ParallelEssentialValues"),
+		1,
+		TEXT("Compute the essential values of batched characters over worker threads before they tick."),
+		ECVF_Default);
+
+	/** Essential values of a single character are too cheap to be a task of their own */
+	constexpr int32 CharactersPerTask = 64;
+}
+
+FALSCharacterTickFunction::FALSCharacterTickFunction()
+{
+	TickGroup = TG_PrePhysics;
+	bCanEverTick = true;
+	bStartWithTickEnabled = true;
+}
+
+void FALSCharacterTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType,
+                                            ENamedThreads::Type CurrentThread,
+                                            const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Subsystem)
+	{
+		Subsystem->TickCharacters(DeltaTime, TickType);
+	}
+}
+
+FString FALSCharacterTickFunction::DiagnosticMessage()
+{
+	return TEXT("FALSCharacterTickFunction");
+}
+
+void UALSTickSubsystem::Deinitialize()
+{
+	if (TickFunction.IsTickFunctionRegistered())
+	{
+		TickFunction.UnRegisterTickFunction();
+	}
+
+	Entries.Reset();
+	Super::Deinitialize();
+}
+
+void UALSTickSubsystem::RegisterCharacter(AALSBaseCharacter* Character)
+{
+	if (!Character || IsRegistered(Character))
+	{
+		return;
+	}
+
+	if (!TickFunction.IsTickFunctionRegistered())
+	{
+		TickFunction.Subsystem = this;
+		TickFunction.RegisterTickFunction(GetWorld()->PersistentLevel);
+	}
+
+	// Same guarantees as the character tick: after the movement component, before the mesh
+	UCharacterMovementComponent* CharacterMovement = Character->GetCharacterMovement();
+	TickFunction.AddPrerequisite(CharacterMovement, CharacterMovement->PrimaryComponentTick);
+	Character->GetMesh()->PrimaryComponentTick.AddPrerequisite(this, TickFunction);
+	Character->RegisterAllActorTickFunctions(false, false);
+
+	FEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Character = Character;
+
+	TInlineComponentArray<UActorComponent*> Components(Character);
+	for (UActorComponent* Component : Components)
+	{
+		if (Component->IsA<UALSMantleComponent>() || Component->IsA<UALSDebugComponent>())
+		{
+			Component->RegisterAllComponentTickFunctions(false);
+			Entry.Components.Add(Component);
+		}
+	}
+}
+
+void UALSTickSubsystem::UnregisterCharacter(AALSBaseCharacter* Character)
+{
+	if (!Character || Entries.RemoveAll([Character](const FEntry& Entry) { return Entry.Character == Character; }) == 0)
+	{
+		return;
+	}
+
+	UCharacterMovementComponent* CharacterMovement = Character->GetCharacterMovement();
+	TickFunction.RemovePrerequisite(CharacterMovement, CharacterMovement->PrimaryComponentTick);
+	Character->GetMesh()->PrimaryComponentTick.RemovePrerequisite(this, TickFunction);
+}
+
+bool UALSTickSubsystem::IsRegistered(const AALSBaseCharacter* Character) const
+{
+	return Entries.ContainsByPredicate([Character](const FEntry& Entry) { return Entry.Character == Character; });
+}
+
+void UALSTickSubsystem::TickCharacters(float DeltaTime, ELevelTick TickType)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ALS_BatchedCharacterTick);
+
+	if (TickType == LEVELTICK_ViewportsOnly)
+	{
+		return;
+	}
+
+	// Removing keeps the order, characters tick in the order they registered
+	Entries.RemoveAll([](const FEntry& Entry) { return !Entry.Character.IsValid(); });
+
+	// Time dilation is applied by the tick functions the batch replaces. Characters with a tick interval, e.g. from
+	// their tick bucket, tick once it elapsed with the time of all frames they skipped.
+	for (FEntry& Entry : Entries)
+	{
+		const AALSBaseCharacter* Character = Entry.Character.Get();
+		Entry.PendingTime += DeltaTime * Character->CustomTimeDilation;
+		Entry.bTickThisFrame = Entry.PendingTime >= Character->PrimaryActorTick.TickInterval;
+	}
+
+	if (ALSBatchedTick::CVarParallelEssentialValues.GetValueOnGameThread())
+	{
+		UpdateEssentialValues();
+	}
+
+	int32 NumCharacters = 0;
+	for (FEntry& Entry : Entries)
+	{
+		AALSBaseCharacter* Character = Entry.Character.Get();
+		if (Character->IsPendingKill() || !Entry.bTickThisFrame)
+		{
+			continue;
+		}
+
+		const float CharacterDeltaTime = Entry.PendingTime;
+		Entry.PendingTime = 0.0f;
+		if (Character->IsActorTickEnabled())
+		{
+			Character->TickActor(CharacterDeltaTime, TickType, Character->PrimaryActorTick);
+			++NumCharacters;
+		}
+
+		for (const TWeakObjectPtr<UActorComponent>& WeakComponent : Entry.Components)
+		{
+			UActorComponent* Component = WeakComponent.Get();
+			if (Component && Component->IsRegistered() && Component->IsComponentTickEnabled())
+			{
+				Component->TickComponent(CharacterDeltaTime, TickType, &Component->PrimaryComponentTick);
+			}
+		}
+	}
+
+	SET_DWORD_STAT(STAT_ALS_BatchedTickCharacters, NumCharacters);
+}
+
+void UALSTickSubsystem::UpdateEssentialValues()
+{
+	SCOPE_CYCLE_COUNTER(STAT_ALS_BatchedEssentialValues);
+
+	EssentialCharacters.Reset(Entries.Num());
+	EssentialInputs.Reset(Entries.Num());
+	for (const FEntry& Entry : Entries)
+	{
+		AALSBaseCharacter* Character = Entry.Character.Get();
+		if (Entry.bTickThisFrame && !Character->IsPendingKill() && Character->IsActorTickEnabled())
+		{
+			Character->GatherEssentialValues(Entry.PendingTime, EssentialInputs.AddDefaulted_GetRef());
+			EssentialCharacters.Add(Character);
+		}
+	}
+
+	const int32 NumCharacters = EssentialInputs.Num();
+	EssentialOutputs.SetNum(NumCharacters, false);
+	const int32 NumTasks = FMath::DivideAndRoundUp(NumCharacters, ALSBatchedTick::CharactersPerTask);
+	ParallelFor(NumTasks, [this, NumCharacters](int32 Task)
+	{
+		const int32 First = Task * ALSBatchedTick::CharactersPerTask;
+		const int32 Last = FMath::Min(First + ALSBatchedTick::CharactersPerTask, NumCharacters);
+		for (int32 Index = First; Index < Last; ++Index)
+		{
+			AALSBaseCharacter::ComputeEssentialValues(EssentialInputs[Index], EssentialOutputs[Index]);
+		}
+	}, NumTasks < 2);
+
+	for (int32 Index = 0; Index < NumCharacters; ++Index)
+	{
+		EssentialCharacters[Index]->ApplyEssentialValues(EssentialOutputs[Index]);
+	}
+}
@@ -0,0 +1,120 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Character/Animation/ALSAnimCurveCache.h"
+#include "Animation/AnimCurveTypes.h"
+#include "Animation/Skeleton.h"
+
+namespace ALSAnimCurveCache
+{
+	/** Also read by anim nodes caching their bones, the names are built once on first use from any thread */
+	const TArray<FName>& GetCurveNames()
+	{
+		static const TArray<FName> CurveNames = []
+		{
+			TArray<FName> Names;
+			const UEnum* CurveEnum = StaticEnum<EALSAnimCurve>();
+			Names.Reserve(FALSAnimCurveCache::NumCurves);
+			for (int32 Index = 0; Index < FALSAnimCurveCache::NumCurves; ++Index)
+			{
+				Names.Add(FName(*CurveEnum->GetNameStringByIndex(Index)));
+			}
+			return Names;
+		}();
+		return CurveNames;
+	}
+
+	/** Resolved curves per skeleton */
+	TMap<TWeakObjectPtr<const USkeleton>, TSharedRef<TArray<FALSAnimCurveCache::FResolvedCurve>>> SkeletonRegistry;
+}
+
+void FALSAnimCurveCache::Initialize(const USkeleton* Skeleton)
+{
+	check(IsInGameThread());
+	Reset();
+
+	auto* Found = ALSAnimCurveCache::SkeletonRegistry.Find(Skeleton);
+	if (Found)
+	{
+		ResolvedCurves = *Found;
+		return;
+	}
+
+	// Without a skeleton, no curve can be read by UID
+	TSharedRef<TArray<FResolvedCurve>> Resolved = MakeShared<TArray<FResolvedCurve>>();
+	const FSmartNameMapping* CurveMapping = Skeleton
+		                                        ? Skeleton->GetSmartNameContainer(USkeleton::AnimCurveMappingName)
+		                                        : nullptr;
+	const TArray<FName>& CurveNames = ALSAnimCurveCache::GetCurveNames();
+	for (int32 Index = 0; CurveMapping && Index < NumCurves; ++Index)
+	{
+		const SmartName::UID_Type UID = CurveMapping->FindUID(CurveNames[Index]);
+		if (UID != SmartName::MaxUID)
+		{
+			Resolved->Add({static_cast<uint8>(Index), UID});
+		}
+	}
+
+	if (Skeleton)
+	{
+		// Drop the entries of unloaded skeletons before adding a new one
+		for (auto It = ALSAnimCurveCache::SkeletonRegistry.CreateIterator(); It; ++It)
+		{
+			if (!It.Key().IsValid())
+			{
+				It.RemoveCurrent();
+			}
+		}
+		ALSAnimCurveCache::SkeletonRegistry.Add(Skeleton, Resolved);
+	}
+
+	ResolvedCurves = Resolved;
+}
+
+void FALSAnimCurveCache::Refresh(const FBlendedCurve& Curve)
+{
+	if (!ResolvedCurves.IsValid())
+	{
+		return;
+	}
+
+	// Curves missing from the evaluated pose, e.g. filtered out by LOD, read as 0 like in the curve map
+	for (const FResolvedCurve& Resolved : *ResolvedCurves)
+	{
+		const int32 Index = Resolved.Index;
+		Values[Index] = Curve.Get(Resolved.UID);
+		if (!FMath::IsNearlyEqual(Values[Index], ReportedValues[Index], ChangeTolerance))
+		{
+			ReportedValues[Index] = Values[Index];
+			ChangedCurves |= uint64(1) << Index;
+		}
+	}
+}
+
+void FALSAnimCurveCache::Reset()
+{
+	FMemory::Memzero(Values);
+	FMemory::Memzero(ReportedValues);
+	ChangedCurves = ~uint64(0);
+}
+
+FName FALSAnimCurveCache::GetCurveName(EALSAnimCurve Curve)
+{
+	return ALSAnimCurveCache::GetCurveNames()[static_cast<int32>(Curve)];
+}
+
+FArchive& operator<<(FArchive& Ar, FALSAnimCurveCache& Cache)
+{
+	for (int32 Index = 0; Index < FALSAnimCurveCache::NumCurves; ++Index)
+	{
+		Ar << Cache.Values[Index];
+		Ar << Cache.ReportedValues[Index];
+	}
+	Ar << Cache.ChangedCurves;
+	return Ar;
+}
@@ -0,0 +1,35 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Character/Animation/ALSAnimInstanceProxy.h"
+#include "Character/Animation/ALSCharacterAnimInstance.h"
+
+void FALSAnimInstanceProxy::Update(float DeltaSeconds)
+{
+	Super::Update(DeltaSeconds);
+
+	UALSCharacterAnimInstance* AnimInstance = Cast<UALSCharacterAnimInstance>(GetAnimInstanceObject());
+	if (AnimInstance)
+	{
+		AnimInstance->NativeThreadSafeUpdateAnimation(DeltaSeconds);
+	}
+}
+
+bool FALSAnimInstanceProxy::Evaluate_WithRoot(FPoseContext& Output, FAnimNode_Base* InRootNode)
+{
+	EvaluateAnimationNode_WithRoot(Output, InRootNode);
+
+	// Linked layers evaluate through the same proxy with their own root, only the main graph has the final curves
+	UALSCharacterAnimInstance* AnimInstance = Cast<UALSCharacterAnimInstance>(GetAnimInstanceObject());
+	if (AnimInstance && InRootNode == RootNode)
+	{
+		AnimInstance->CurveCache.Refresh(Output.Curve);
+	}
+
+	return true;
+}
@@ -0,0 +1,235 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Character/Animation/ALSAnimKernelSubsystem.h"
+
+#include "ALSV4_CPP.h"
+#include "Character/ALSBaseCharacter.h"
+#include "Character/Animation/ALSCharacterAnimInstance.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "EngineUtils.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Anim Kernels"), STAT_ALS_AnimKernels, STATGROUP_ALS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Anim Kernel Characters"), STAT_ALS_AnimKernelCharacters, STATGROUP_ALS);
+
+namespace ALSAnimKernels
+{
+	TAutoConsoleVariable<int32> CVarEnable(
+		TEXT("als.AnimKernels.Enable"),
+		1,
+		TEXT("Compute anim values of characters which registered for batched anim kernels in one batch."),
+		ECVF_Default);
+
+	TAutoConsoleVariable<int32> CVarParallel(
+		TEXT("als.AnimKernels.Parallel"),
+		1,
+		TEXT("Spread large batches of anim kernels over worker threads."),
+		ECVF_Default);
+
+	FAutoConsoleCommandWithWorldAndArgs BenchmarkCommand(
+		TEXT("als.AnimKernels.Benchmark"),
+		TEXT("Time the calculations of the anim instances of the ALS characters in the world against the batched "
+			"anim kernels. Argument is the number of iterations, 100 by default."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			const UALSAnimKernelSubsystem* Subsystem = World ? World->GetSubsystem<UALSAnimKernelSubsystem>() : nullptr;
+			if (Subsystem)
+			{
+				Subsystem->Benchmark(Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 100);
+			}
+		}));
+}
+
+FALSAnimKernelTickFunction::FALSAnimKernelTickFunction()
+{
+	TickGroup = TG_PrePhysics;
+	bCanEverTick = true;
+	bStartWithTickEnabled = true;
+}
+
+void FALSAnimKernelTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType,
+                                             ENamedThreads::Type CurrentThread,
+                                             const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Subsystem && TickType != LEVELTICK_ViewportsOnly)
+	{
+		Subsystem->RunKernels();
+	}
+}
+
+FString FALSAnimKernelTickFunction::DiagnosticMessage()
+{
+	return TEXT("FALSAnimKernelTickFunction");
+}
+
+void UALSAnimKernelSubsystem::Deinitialize()
+{
+	if (TickFunction.IsTickFunctionRegistered())
+	{
+		TickFunction.UnRegisterTickFunction();
+	}
+
+	Characters.Reset();
+	BatchCharacters.Reset();
+	Super::Deinitialize();
+}
+
+void UALSAnimKernelSubsystem::RegisterCharacter(AALSBaseCharacter* Character)
+{
+	if (!Character || Characters.Contains(Character))
+	{
+		return;
+	}
+
+	if (!TickFunction.IsTickFunctionRegistered())
+	{
+		TickFunction.Subsystem = this;
+		TickFunction.RegisterTickFunction(GetWorld()->PersistentLevel);
+	}
+
+	// Inputs are complete once the character and its movement ticked, results are read by the mesh update
+	UCharacterMovementComponent* CharacterMovement = Character->GetCharacterMovement();
+	Character->AddUpdatePrerequisite(TickFunction);
+	TickFunction.AddPrerequisite(CharacterMovement, CharacterMovement->PrimaryComponentTick);
+	Character->GetMesh()->PrimaryComponentTick.AddPrerequisite(this, TickFunction);
+
+	Characters.Add(Character);
+}
+
+void UALSAnimKernelSubsystem::UnregisterCharacter(AALSBaseCharacter* Character)
+{
+	if (!Character || Characters.Remove(Character) == 0)
+	{
+		return;
+	}
+
+	UCharacterMovementComponent* CharacterMovement = Character->GetCharacterMovement();
+	Character->RemoveUpdatePrerequisite(TickFunction);
+	TickFunction.RemovePrerequisite(CharacterMovement, CharacterMovement->PrimaryComponentTick);
+	Character->GetMesh()->PrimaryComponentTick.RemovePrerequisite(this, TickFunction);
+}
+
+void UALSAnimKernelSubsystem::RunKernels()
+{
+	SCOPE_CYCLE_COUNTER(STAT_ALS_AnimKernels);
+
+	if (!ALSAnimKernels::CVarEnable.GetValueOnGameThread())
+	{
+		return;
+	}
+
+	Characters.RemoveAllSwap([](const TWeakObjectPtr<AALSBaseCharacter>& Character) { return !Character.IsValid(); });
+	Batch.SetNum(Characters.Num());
+	BatchCharacters.Reset(Characters.Num());
+
+	// Characters which can't provide inputs (e.g. a follower of anim sharing) keep zero inputs in their slot
+	FALSAnimKernelInput Input;
+	for (int32 Index = 0; Index < Characters.Num(); ++Index)
+	{
+		AALSBaseCharacter* Character = Characters[Index].Get();
+		const UALSCharacterAnimInstance* AnimInstance = Character->GetMainAnimInstance();
+		const bool bGathered = AnimInstance && Character->GetMesh()->PrimaryComponentTick.IsTickFunctionEnabled() &&
+			AnimInstance->GetKernelInput(Input);
+		BatchCharacters.Add(bGathered ? Character : nullptr);
+		if (bGathered)
+		{
+			Batch.SetInput(Index, Input);
+		}
+	}
+
+	Batch.Run(ALSAnimKernels::CVarParallel.GetValueOnGameThread() != 0);
+
+	FALSAnimKernelOutput Output;
+	int32 NumCharacters = 0;
+	for (int32 Index = 0; Index < BatchCharacters.Num(); ++Index)
+	{
+		if (BatchCharacters[Index])
+		{
+			Batch.GetOutput(Index, Output);
+			BatchCharacters[Index]->GetMainAnimInstance()->SetKernelOutput(Output);
+			++NumCharacters;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_ALS_AnimKernelCharacters, NumCharacters);
+}
+
+void UALSAnimKernelSubsystem::Benchmark(int32 Iterations) const
+{
+	TArray<UALSCharacterAnimInstance*> AnimInstances;
+	FALSAnimKernelInput Input;
+	for (TActorIterator<AALSBaseCharacter> It(GetWorld()); It; ++It)
+	{
+		UALSCharacterAnimInstance* AnimInstance = It->GetMainAnimInstance();
+		if (AnimInstance && AnimInstance->GetKernelInput(Input))
+		{
+			AnimInstances.Add(AnimInstance);
+		}
+	}
+
+	const int32 Count = AnimInstances.Num();
+	if (Count == 0)
+	{
+		UE_LOG(LogALS, Warning, TEXT("No ALS character in the world can run the anim kernels"));
+		return;
+	}
+
+	// What the anim instances compute when the kernels don't run for them
+	TArray<FALSAnimKernelOutput> Outputs;
+	Outputs.SetNum(Count);
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			AnimInstances[Index]->CalculateKernelValues(Outputs[Index]);
+		}
+	}
+	const double PerCharacterTime = (FPlatformTime::Seconds() - StartTime) / Iterations;
+
+	// Gather and scatter are timed as RunKernels pays them, the outputs aren't handed to the anim instances though
+	FALSAnimKernelBatch BenchmarkBatch;
+	double KernelTime = 0.0;
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		BenchmarkBatch.SetNum(Count);
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			AnimInstances[Index]->GetKernelInput(Input);
+			BenchmarkBatch.SetInput(Index, Input);
+		}
+
+		const double KernelStartTime = FPlatformTime::Seconds();
+		BenchmarkBatch.Run(ALSAnimKernels::CVarParallel.GetValueOnGameThread() != 0);
+		KernelTime += FPlatformTime::Seconds() - KernelStartTime;
+
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			BenchmarkBatch.GetOutput(Index, Outputs[Index]);
+		}
+	}
+	const double BatchedTime = (FPlatformTime::Seconds() - StartTime) / Iterations;
+
+	// Anim instances compute from their last update, only the scalar kernels use the same inputs as the batch
+	float Error = 0.0f;
+	FALSAnimKernelOutput Expected;
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		AnimInstances[Index]->GetKernelInput(Input);
+		ALSAnimKernels::Compute(Input, Expected);
+		Error = FMath::Max(Error, ALSAnimKernels::MaxError(Expected, Outputs[Index]));
+	}
+
+	UE_LOG(LogALS, Display,
+	       TEXT("ALS anim kernels, %d characters: anim instances %.1f us, batched %.1f us (kernels %.1f us), "
+		       "max error to the scalar kernels %g"), Count, PerCharacterTime * 1e6, BatchedTime * 1e6,
+	       KernelTime / Iterations * 1e6, Error);
+}
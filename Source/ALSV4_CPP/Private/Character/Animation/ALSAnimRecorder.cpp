@@ -0,0 +1,464 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Character/Animation/ALSAnimRecorder.h"
+
+#include "ALSV4_CPP.h"
+#include "Character/Animation/ALSCharacterAnimInstance.h"
+#include "GameFramework/Actor.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/ArchiveLoadCompressedProxy.h"
+#include "Serialization/ArchiveSaveCompressedProxy.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+#include "UObject/UObjectIterator.h"
+
+namespace ALSAnimRecorder
+{
+	struct FActiveRecording
+	{
+		TArray<TWeakObjectPtr<UALSCharacterAnimInstance>> AnimInstances;
+
+		/** Owned here, an anim instance destroyed while recording leaves its track behind */
+		TArray<TUniquePtr<FALSAnimRecordingTrack>> Tracks;
+	};
+
+	TUniquePtr<FActiveRecording> ActiveRecording;
+
+	template <typename StructType>
+	void SerializeStruct(FArchive& Ar, StructType& Struct)
+	{
+		StructType::StaticStruct()->SerializeBin(Ar, &Struct);
+	}
+
+	template <typename EnumType, typename WrapperType>
+	void SerializeEnum(FArchive& Ar, WrapperType& Wrapper)
+	{
+		uint8 Value = static_cast<uint8>(static_cast<EnumType>(Wrapper));
+		Ar << Value;
+		if (Ar.IsLoading())
+		{
+			Wrapper = static_cast<EnumType>(Value);
+		}
+	}
+
+	void Serialize(FArchive& Ar, FALSAnimGameThreadValues& Values)
+	{
+		Ar << Values.bValid;
+		Ar << Values.bIsMovingOnGround;
+		Ar << Values.bIsAutonomousProxy;
+		Ar << Values.bHasKernelOutput;
+		Ar << Values.MaxAcceleration;
+		Ar << Values.MaxBrakingDeceleration;
+		Ar << Values.MeshScaleZ;
+		Ar << Values.UpdateRateScale;
+		Ar << Values.MeshRotation;
+		Ar << Values.LastUpdateRotation;
+		Ar << Values.IKFoot_L;
+		Ar << Values.IKFoot_R;
+		Ar << Values.FootOffset_L_Target;
+		Ar << Values.FootOffset_R_Target;
+		Ar << Values.FootOffset_L_RotationTarget;
+		Ar << Values.FootOffset_R_RotationTarget;
+		Ar << Values.LandPredictionTime;
+		Ar << Values.RagdollVelocity;
+		Ar << Values.FootIKTraceWeight;
+		Ar << Values.LandPredictionWeight;
+		Ar << Values.AimSmoothingWeight;
+	}
+
+	void Serialize(FArchive& Ar, FALSAnimKernelOutput& Output)
+	{
+		SerializeStruct(Ar, Output.VelocityBlend);
+		Ar << Output.RelativeAcceleration;
+		Ar << Output.StandingSpeedRate;
+		Ar << Output.CrouchingSpeedRate;
+		SerializeStruct(Ar, Output.AirLean);
+	}
+
+	void Serialize(FArchive& Ar, FALSAnimExtrapolationState& State)
+	{
+		Ar << State.bApplied;
+		SerializeStruct(Ar, State.VelocityBlend);
+		SerializeStruct(Ar, State.LeanAmount);
+		Ar << State.SmoothedAimingRotation;
+		Ar << State.SmoothedAimingAngle;
+		Ar << State.FootOffset_L_Location;
+		Ar << State.FootOffset_R_Location;
+		Ar << State.FootOffset_L_Rotation;
+		Ar << State.FootOffset_R_Rotation;
+	}
+}
+
+bool FALSAnimRecording::Save(const FString& FileName) const
+{
+	TArray<uint8> CompressedData;
+	{
+		FArchiveSaveCompressedProxy Ar(CompressedData, NAME_Zlib);
+		uint32 FileMagic = Magic;
+		uint32 FileVersion = Version;
+		Ar << FileMagic << FileVersion;
+
+		// Saving archives only read the tracks
+		const_cast<FALSAnimRecording*>(this)->SerializeTracks(Ar);
+		Ar.Flush();
+	}
+
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(FileName), true);
+	return FFileHelper::SaveArrayToFile(CompressedData, *FileName);
+}
+
+bool FALSAnimRecording::Load(const FString& FileName)
+{
+	TArray<uint8> CompressedData;
+	if (!FFileHelper::LoadFileToArray(CompressedData, *FileName))
+	{
+		UE_LOG(LogALS, Error, TEXT("Can't read anim recording %s"), *FileName);
+		return false;
+	}
+
+	FArchiveLoadCompressedProxy Ar(CompressedData, NAME_Zlib);
+	uint32 FileMagic = 0;
+	uint32 FileVersion = 0;
+	Ar << FileMagic << FileVersion;
+	if (Ar.IsError() || FileMagic != Magic)
+	{
+		UE_LOG(LogALS, Error, TEXT("%s is not an anim recording"), *FileName);
+		return false;
+	}
+
+	if (FileVersion != Version)
+	{
+		UE_LOG(LogALS, Error, TEXT("%s is recorded with version %u, this build replays version %u. Record it again."),
+		       *FileName, FileVersion, Version);
+		return false;
+	}
+
+	SerializeTracks(Ar);
+	if (Ar.IsError())
+	{
+		UE_LOG(LogALS, Error, TEXT("Anim recording %s is truncated"), *FileName);
+		return false;
+	}
+	return true;
+}
+
+void FALSAnimRecording::SerializeTracks(FArchive& Ar)
+{
+	int32 NumTracks = Tracks.Num();
+	Ar << NumTracks;
+	if (Ar.IsLoading())
+	{
+		if (Ar.IsError() || NumTracks < 0)
+		{
+			Ar.SetError();
+			return;
+		}
+		Tracks.SetNum(NumTracks);
+	}
+
+	for (FALSAnimRecordingTrack& Track : Tracks)
+	{
+		// Plain archives don't serialize names, the class is stored by its path
+		FString AnimClassPath = Track.AnimClass.ToString();
+		Ar << Track.Name;
+		Ar << AnimClassPath;
+		Ar << Track.NumFrames;
+		Ar << Track.Data;
+		if (Ar.IsLoading())
+		{
+			Track.AnimClass = AnimClassPath;
+		}
+	}
+}
+
+void FALSAnimRecorder::Start(UWorld* World)
+{
+	using namespace ALSAnimRecorder;
+
+	if (ActiveRecording)
+	{
+		UE_LOG(LogALS, Warning, TEXT("Anim updates are recorded already"));
+		return;
+	}
+
+	ActiveRecording = MakeUnique<FActiveRecording>();
+	for (TObjectIterator<UALSCharacterAnimInstance> It; It; ++It)
+	{
+		UALSCharacterAnimInstance* AnimInstance = *It;
+		if (AnimInstance->IsTemplate() || AnimInstance->IsPendingKill() || AnimInstance->GetWorld() != World)
+		{
+			continue;
+		}
+
+		FALSAnimRecordingTrack& Track = *ActiveRecording->Tracks.Add_GetRef(MakeUnique<FALSAnimRecordingTrack>());
+		Track.Name = AnimInstance->GetOwningActor()->GetName();
+		Track.AnimClass = AnimInstance->GetClass();
+		AnimInstance->RecordingTrack = &Track;
+		ActiveRecording->AnimInstances.Add(AnimInstance);
+	}
+
+	UE_LOG(LogALS, Display, TEXT("Recording the anim updates of %d ALS anim instances"),
+	       ActiveRecording->AnimInstances.Num());
+}
+
+bool FALSAnimRecorder::Stop(const FString& FileName)
+{
+	using namespace ALSAnimRecorder;
+
+	if (!ActiveRecording)
+	{
+		UE_LOG(LogALS, Warning, TEXT("Anim updates are not recorded"));
+		return false;
+	}
+
+	for (const TWeakObjectPtr<UALSCharacterAnimInstance>& AnimInstance : ActiveRecording->AnimInstances)
+	{
+		if (AnimInstance.IsValid())
+		{
+			AnimInstance->RecordingTrack = nullptr;
+		}
+	}
+
+	FALSAnimRecording Recording;
+	int32 NumFrames = 0;
+	for (TUniquePtr<FALSAnimRecordingTrack>& Track : ActiveRecording->Tracks)
+	{
+		if (Track->NumFrames > 0)
+		{
+			NumFrames += Track->NumFrames;
+			Recording.Tracks.Add(MoveTemp(*Track));
+		}
+	}
+	ActiveRecording.Reset();
+
+	if (!Recording.Save(FileName))
+	{
+		UE_LOG(LogALS, Error, TEXT("Failed to save anim recording %s"), *FileName);
+		return false;
+	}
+
+	UE_LOG(LogALS, Display, TEXT("Saved %d anim updates of %d anim instances to %s"), NumFrames,
+	       Recording.Tracks.Num(), *FileName);
+	return true;
+}
+
+bool FALSAnimRecorder::IsRecording()
+{
+	return ALSAnimRecorder::ActiveRecording.IsValid();
+}
+
+void FALSAnimRecorder::RecordUpdateStart(UALSCharacterAnimInstance& AnimInstance, float DeltaSeconds)
+{
+	FALSAnimRecordingTrack& Track = *AnimInstance.RecordingTrack;
+	FMemoryWriter Ar(Track.Data);
+	Ar.Seek(Track.Data.Num());
+	Ar << DeltaSeconds;
+	SerializeInputs(Ar, AnimInstance);
+	SerializeState(Ar, AnimInstance);
+}
+
+void FALSAnimRecorder::RecordUpdateEnd(UALSCharacterAnimInstance& AnimInstance)
+{
+	FALSAnimRecordingTrack& Track = *AnimInstance.RecordingTrack;
+	uint32 Checksum = GetStateChecksum(AnimInstance);
+	FMemoryWriter Ar(Track.Data);
+	Ar.Seek(Track.Data.Num());
+	Ar << Checksum;
+	++Track.NumFrames;
+}
+
+bool FALSAnimRecorder::Replay(const FALSAnimRecording& Recording, int32 Iterations, FALSAnimReplayResult& OutResult)
+{
+	OutResult = FALSAnimReplayResult();
+
+	// Anim instances are not initialized against a mesh, the replayed update doesn't touch it
+	TArray<TStrongObjectPtr<UALSCharacterAnimInstance>> AnimInstances;
+	for (const FALSAnimRecordingTrack& Track : Recording.Tracks)
+	{
+		UClass* AnimClass = Track.AnimClass.TryLoadClass<UALSCharacterAnimInstance>();
+		if (!AnimClass)
+		{
+			UE_LOG(LogALS, Error, TEXT("Anim class %s of %s can't be loaded"), *Track.AnimClass.ToString(),
+			       *Track.Name);
+			return false;
+		}
+
+		UALSCharacterAnimInstance* AnimInstance = NewObject<UALSCharacterAnimInstance>(
+			GetTransientPackage(), AnimClass);
+		AnimInstance->InitializeFromAnimConfig();
+		AnimInstances.Emplace(AnimInstance);
+		OutResult.NumFrames += Track.NumFrames;
+	}
+
+	uint64 UpdateCycles = 0;
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		for (int32 TrackIndex = 0; TrackIndex < Recording.Tracks.Num(); ++TrackIndex)
+		{
+			const FALSAnimRecordingTrack& Track = Recording.Tracks[TrackIndex];
+			UALSCharacterAnimInstance& AnimInstance = *AnimInstances[TrackIndex];
+			FMemoryReader Ar(Track.Data);
+			for (int32 Frame = 0; Frame < Track.NumFrames; ++Frame)
+			{
+				float DeltaSeconds = 0.0f;
+				uint32 RecordedChecksum = 0;
+				Ar << DeltaSeconds;
+				SerializeInputs(Ar, AnimInstance);
+				SerializeState(Ar, AnimInstance);
+				Ar << RecordedChecksum;
+				if (Ar.IsError())
+				{
+					UE_LOG(LogALS, Error, TEXT("Frame %d of %s is truncated"), Frame, *Track.Name);
+					return false;
+				}
+
+				const uint64 StartCycles = FPlatformTime::Cycles64();
+				AnimInstance.NativeThreadSafeUpdateAnimation(DeltaSeconds);
+				UpdateCycles += FPlatformTime::Cycles64() - StartCycles;
+
+				if (Iteration == 0 && GetStateChecksum(AnimInstance) != RecordedChecksum &&
+					OutResult.NumMismatches++ == 0)
+				{
+					OutResult.FirstMismatch = FString::Printf(TEXT("%s frame %d"), *Track.Name, Frame);
+				}
+			}
+		}
+	}
+
+	OutResult.UpdateSeconds = FPlatformTime::ToSeconds64(UpdateCycles);
+	return true;
+}
+
+bool FALSAnimRecorder::ReplayFile(const FString& FileName, int32 Iterations)
+{
+	FALSAnimRecording Recording;
+	FALSAnimReplayResult Result;
+	Iterations = FMath::Max(Iterations, 1);
+	if (!Recording.Load(FileName) || !Replay(Recording, Iterations, Result))
+	{
+		return false;
+	}
+
+	const int32 NumUpdates = Result.NumFrames * Iterations;
+	UE_LOG(LogALS, Display, TEXT("Replayed %d updates of %d anim instances %d times, %.3f us per update"),
+	       Result.NumFrames, Recording.Tracks.Num(), Iterations,
+	       NumUpdates > 0 ? Result.UpdateSeconds * 1000000.0 / NumUpdates : 0.0);
+
+	if (Result.NumMismatches > 0)
+	{
+		UE_LOG(LogALS, Error, TEXT("%d of %d updates differ from the recording, first one is %s"),
+		       Result.NumMismatches, Result.NumFrames, *Result.FirstMismatch);
+		return false;
+	}
+
+	UE_LOG(LogALS, Display, TEXT("All updates match the recording"));
+	return true;
+}
+
+FString FALSAnimRecorder::GetDefaultFileName()
+{
+	return FPaths::ProjectSavedDir() / TEXT("ALSAnimRecordings") /
+		FString::Printf(TEXT("ALSAnim_%s.alsrec"), *FDateTime::Now().ToString());
+}
+
+void FALSAnimRecorder::SerializeInputs(FArchive& Ar, UALSCharacterAnimInstance& AnimInstance)
+{
+	using namespace ALSAnimRecorder;
+
+	SerializeStruct(Ar, AnimInstance.CharacterInformation);
+	SerializeEnum<EALSMovementState>(Ar, AnimInstance.MovementState);
+	SerializeEnum<EALSMovementAction>(Ar, AnimInstance.MovementAction);
+	SerializeEnum<EALSRotationMode>(Ar, AnimInstance.RotationMode);
+	SerializeEnum<EALSGait>(Ar, AnimInstance.Gait);
+	SerializeEnum<EALSStance>(Ar, AnimInstance.Stance);
+	SerializeEnum<EALSOverlayState>(Ar, AnimInstance.OverlayState);
+	SerializeEnum<EALSAnimSignificance>(Ar, AnimInstance.SignificanceTier);
+	Ar << AnimInstance.bServerAnimMode;
+
+	// Trace results are part of the game thread values, replays don't trace
+	Serialize(Ar, AnimInstance.GameThreadValues);
+	Ar << AnimInstance.CurveCache;
+	if (AnimInstance.GameThreadValues.bHasKernelOutput)
+	{
+		Serialize(Ar, AnimInstance.KernelOutput);
+	}
+}
+
+void FALSAnimRecorder::SerializeState(FArchive& Ar, UALSCharacterAnimInstance& AnimInstance)
+{
+	using namespace ALSAnimRecorder;
+
+	SerializeStruct(Ar, AnimInstance.Grounded);
+	SerializeStruct(Ar, AnimInstance.VelocityBlend);
+	SerializeStruct(Ar, AnimInstance.LeanAmount);
+	Ar << AnimInstance.RelativeAccelerationAmount;
+	SerializeEnum<EALSGroundedEntryState>(Ar, AnimInstance.GroundedEntryState);
+	SerializeEnum<EALSMovementDirection>(Ar, AnimInstance.MovementDirection);
+	SerializeStruct(Ar, AnimInstance.InAir);
+	SerializeStruct(Ar, AnimInstance.AimingValues);
+	Ar << AnimInstance.SmoothedAimingAngle;
+	Ar << AnimInstance.FlailRate;
+	SerializeStruct(Ar, AnimInstance.LayerBlendingValues);
+	SerializeStruct(Ar, AnimInstance.FootIKValues);
+
+	SerializeStruct(Ar, AnimInstance.TargetVelocityBlend);
+	Serialize(Ar, AnimInstance.Extrapolation);
+	Ar << AnimInstance.StrideInputs;
+	Ar << AnimInstance.VelocityBlendInputs;
+	Ar << AnimInstance.DiagonalScaleInputs;
+	Ar << AnimInstance.YawOffsetInputs;
+}
+
+uint32 FALSAnimRecorder::GetStateChecksum(UALSCharacterAnimInstance& AnimInstance)
+{
+	TArray<uint8> State;
+	FMemoryWriter Ar(State);
+	SerializeState(Ar, AnimInstance);
+	return FCrc::MemCrc32(State.GetData(), State.Num());
+}
+
+namespace ALSAnimRecorder
+{
+	void StopRecording(const TArray<FString>& Args)
+	{
+		FALSAnimRecorder::Stop(Args.Num() > 0 ? Args[0] : FALSAnimRecorder::GetDefaultFileName());
+	}
+
+	void ReplayRecording(const TArray<FString>& Args)
+	{
+		if (Args.Num() == 0)
+		{
+			UE_LOG(LogALS, Warning, TEXT("Usage: als.AnimReplay <File> [Iterations]"));
+			return;
+		}
+
+		FALSAnimRecorder::ReplayFile(Args[0], Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 1);
+	}
+
+	FAutoConsoleCommandWithWorld StartCommand(
+		TEXT("als.AnimRecord.Start"),
+		TEXT("Record the thread safe anim updates of the ALS characters in the world."),
+		FConsoleCommandWithWorldDelegate::CreateStatic(&FALSAnimRecorder::Start));
+
+	FAutoConsoleCommandWithArgs StopCommand(
+		TEXT("als.AnimRecord.Stop"),
+		TEXT("Stop recording anim updates and save them, to Saved/ALSAnimRecordings unless a file is given."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&StopRecording));
+
+	FAutoConsoleCommandWithArgs ReplayCommand(
+		TEXT("als.AnimReplay"),
+		TEXT("Replay a recording of anim updates, compare the results and time the updates. "
+			"Arguments: file, number of iterations."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&ReplayRecording));
+}
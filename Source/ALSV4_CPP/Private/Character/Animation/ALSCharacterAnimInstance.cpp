@@ -7,23 +7,346 @@
 
 
 #include "Character/Animation/ALSCharacterAnimInstance.h"
+#include "Character/Animation/ALSAnimInstanceProxy.h"
+#include "Character/Animation/ALSAnimConfig.h"
+#include "Character/Animation/ALSAnimRecorder.h"
 #include "Character/ALSBaseCharacter.h"
 #include "Library/ALSMathLibrary.h"
 #include "Curves/CurveVector.h"
 #include "Components/CapsuleComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "PhysicsEngine/BodyInstance.h"
+#include "HAL/IConsoleManager.h"
+#include "ALSV4_CPP.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Foot IK Trace Cache Hits"), STAT_ALS_FootIKTraceCacheHits, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Foot IK Trace Cache Misses"), STAT_ALS_FootIKTraceCacheMisses, STATGROUP_ALS);
+// Running totals, hits over lookups is the hit rate since the stats were started
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Foot IK Trace Cache Hits Total"), STAT_ALS_FootIKTraceCacheHitsTotal,
+                               STATGROUP_ALS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Foot IK Trace Cache Lookups Total"), STAT_ALS_FootIKTraceCacheLookupsTotal,
+                               STATGROUP_ALS);
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Characters Full"), STAT_ALS_NumFull, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Characters Reduced"), STAT_ALS_NumReduced, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Characters Minimal"), STAT_ALS_NumMinimal, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Characters Pose Cache"), STAT_ALS_NumPoseCache, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Characters Frozen"), STAT_ALS_NumFrozen, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Anim Update Full"), STAT_ALS_UpdateFull, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Anim Update Reduced"), STAT_ALS_UpdateReduced, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Anim Update Minimal"), STAT_ALS_UpdateMinimal, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Anim Update Pose Cache"), STAT_ALS_UpdatePoseCache, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Anim Update Frozen"), STAT_ALS_UpdateFrozen, STATGROUP_ALS);
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Anim Values Recomputed"), STAT_ALS_ValuesRecomputed, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Anim Values Reused"), STAT_ALS_ValuesReused, STATGROUP_ALS);
+
+namespace ALSSignificanceStats
+{
+	TStatId GetUpdateStatId(EALSAnimSignificance Tier)
+	{
+		switch (Tier)
+		{
+		case EALSAnimSignificance::Reduced:
+			return GET_STATID(STAT_ALS_UpdateReduced);
+		case EALSAnimSignificance::Minimal:
+			return GET_STATID(STAT_ALS_UpdateMinimal);
+		case EALSAnimSignificance::PoseCache:
+			return GET_STATID(STAT_ALS_UpdatePoseCache);
+		case EALSAnimSignificance::Frozen:
+			return GET_STATID(STAT_ALS_UpdateFrozen);
+		default:
+			return GET_STATID(STAT_ALS_UpdateFull);
+		}
+	}
+
+	void CountTier(EALSAnimSignificance Tier)
+	{
+		switch (Tier)
+		{
+		case EALSAnimSignificance::Reduced:
+			INC_DWORD_STAT(STAT_ALS_NumReduced);
+			break;
+		case EALSAnimSignificance::Minimal:
+			INC_DWORD_STAT(STAT_ALS_NumMinimal);
+			break;
+		case EALSAnimSignificance::PoseCache:
+			INC_DWORD_STAT(STAT_ALS_NumPoseCache);
+			break;
+		case EALSAnimSignificance::Frozen:
+			INC_DWORD_STAT(STAT_ALS_NumFrozen);
+			break;
+		default:
+			INC_DWORD_STAT(STAT_ALS_NumFull);
+			break;
+		}
+	}
+}
+
+namespace ALSDirtyTracking
+{
+	/** Curves read by UpdateLayerValues */
+	const uint64 LayerCurves = FALSAnimCurveCache::MakeMask({
+		EALSAnimCurve::Mask_AimOffset, EALSAnimCurve::Enable_HandIK_L, EALSAnimCurve::Enable_HandIK_R,
+		EALSAnimCurve::Layering_Arm_L, EALSAnimCurve::Layering_Arm_R, EALSAnimCurve::BasePose_N,
+		EALSAnimCurve::BasePose_CLF, EALSAnimCurve::Layering_Spine_Add, EALSAnimCurve::Layering_Head_Add,
+		EALSAnimCurve::Layering_Arm_L_Add, EALSAnimCurve::Layering_Arm_R_Add, EALSAnimCurve::Layering_Hand_L,
+		EALSAnimCurve::Layering_Hand_R, EALSAnimCurve::Layering_Arm_L_LS, EALSAnimCurve::Layering_Arm_R_LS
+	});
+
+	bool Count(bool bRecompute)
+	{
+		if (bRecompute)
+		{
+			INC_DWORD_STAT(STAT_ALS_ValuesRecomputed);
+		}
+		else
+		{
+			INC_DWORD_STAT(STAT_ALS_ValuesReused);
+		}
+		return bRecompute;
+	}
+
+	template <int32 NumInputs>
+	bool ShouldRecompute(const FALSAnimConfiguration& Config, TALSAnimDirtyInputs<NumInputs>& DirtyInputs,
+	                     const float (&Inputs)[NumInputs])
+	{
+		if (!Config.bUseDirtyTracking)
+		{
+			DirtyInputs.Invalidate();
+			return true;
+		}
+		return Count(DirtyInputs.Update(Inputs, Config.DirtyTrackingTolerance));
+	}
+}
+
+namespace ALSFootIKTraceCacheStats
+{
+	/** Count a cache lookup, safe from the worker threads updating anim instances */
+	void Record(bool bHit)
+	{
+		if (bHit)
+		{
+			INC_DWORD_STAT(STAT_ALS_FootIKTraceCacheHits);
+			INC_DWORD_STAT(STAT_ALS_FootIKTraceCacheHitsTotal);
+		}
+		else
+		{
+			INC_DWORD_STAT(STAT_ALS_FootIKTraceCacheMisses);
+		}
+		INC_DWORD_STAT(STAT_ALS_FootIKTraceCacheLookupsTotal);
+	}
+}
+
+void UALSCharacterAnimInstance::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	// Blueprint functions may read the configuration before the anim instance is initialized
+	BindAnimConfig();
+}
+
+#if WITH_EDITOR
+namespace ALSAnimConfigMigration
+{
+	template <typename StructType>
+	bool Differs(const StructType& Value, const StructType& ArchetypeValue)
+	{
+		return !StructType::StaticStruct()->CompareScriptStruct(&Value, &ArchetypeValue, PPF_None);
+	}
+}
+
+void UALSCharacterAnimInstance::PostLoad()
+{
+	Super::PostLoad();
+
+	// The configuration of blueprint classes saved before it moved into AnimConfig is copied into a new anim config
+	// asset, stored in the package of the blueprint. Only classes which changed it compared to their parent need one.
+	const UALSCharacterAnimInstance* Archetype = Cast<UALSCharacterAnimInstance>(GetArchetype());
+	if (!HasAnyFlags(RF_ClassDefaultObject) || !Archetype || AnimConfig != Archetype->AnimConfig)
+	{
+		return;
+	}
+
+	const bool bHasOwnConfig =
+		ALSAnimConfigMigration::Differs(Config_DEPRECATED, Archetype->Config_DEPRECATED) ||
+		ALSAnimConfigMigration::Differs(TurnInPlaceValues_DEPRECATED, Archetype->TurnInPlaceValues_DEPRECATED) ||
+		ALSAnimConfigMigration::Differs(RotateInPlace_DEPRECATED, Archetype->RotateInPlace_DEPRECATED) ||
+		ALSAnimConfigMigration::Differs(SignificanceSettings_DEPRECATED, Archetype->SignificanceSettings_DEPRECATED) ||
+		DiagonalScaleAmountCurve_DEPRECATED != Archetype->DiagonalScaleAmountCurve_DEPRECATED ||
+		StrideBlend_N_Walk_DEPRECATED != Archetype->StrideBlend_N_Walk_DEPRECATED ||
+		StrideBlend_N_Run_DEPRECATED != Archetype->StrideBlend_N_Run_DEPRECATED ||
+		StrideBlend_C_Walk_DEPRECATED != Archetype->StrideBlend_C_Walk_DEPRECATED ||
+		LandPredictionCurve_DEPRECATED != Archetype->LandPredictionCurve_DEPRECATED ||
+		LeanInAirCurve_DEPRECATED != Archetype->LeanInAirCurve_DEPRECATED ||
+		YawOffset_FB_DEPRECATED != Archetype->YawOffset_FB_DEPRECATED ||
+		YawOffset_LR_DEPRECATED != Archetype->YawOffset_LR_DEPRECATED ||
+		TransitionAnim_R_DEPRECATED != Archetype->TransitionAnim_R_DEPRECATED ||
+		TransitionAnim_L_DEPRECATED != Archetype->TransitionAnim_L_DEPRECATED;
+	if (!bHasOwnConfig)
+	{
+		return;
+	}
+
+	UPackage* Package = GetOutermost();
+	const FName Name = MakeUniqueObjectName(Package, UALSAnimConfig::StaticClass(),
+	                                        *FString::Printf(TEXT("%s_AnimConfig"), *GetClass()->GetName()));
+	AnimConfig = NewObject<UALSAnimConfig>(Package, Name, RF_Public | RF_Transactional);
+	AnimConfig->Config = Config_DEPRECATED;
+	AnimConfig->TurnInPlace = TurnInPlaceValues_DEPRECATED;
+	AnimConfig->RotateInPlace = RotateInPlace_DEPRECATED;
+	AnimConfig->SignificanceSettings = SignificanceSettings_DEPRECATED;
+	AnimConfig->DiagonalScaleAmountCurve = DiagonalScaleAmountCurve_DEPRECATED;
+	AnimConfig->StrideBlend_N_Walk = StrideBlend_N_Walk_DEPRECATED;
+	AnimConfig->StrideBlend_N_Run = StrideBlend_N_Run_DEPRECATED;
+	AnimConfig->StrideBlend_C_Walk = StrideBlend_C_Walk_DEPRECATED;
+	AnimConfig->LandPredictionCurve = LandPredictionCurve_DEPRECATED;
+	AnimConfig->LeanInAirCurve = LeanInAirCurve_DEPRECATED;
+	AnimConfig->YawOffset_FB = YawOffset_FB_DEPRECATED;
+	AnimConfig->YawOffset_LR = YawOffset_LR_DEPRECATED;
+	AnimConfig->TransitionAnim_R = TransitionAnim_R_DEPRECATED;
+	AnimConfig->TransitionAnim_L = TransitionAnim_L_DEPRECATED;
+	BindAnimConfig();
+	MarkPackageDirty();
+
+	UE_LOG(LogALS, Warning, TEXT("Moved the configuration of %s into %s, save the package to keep it."),
+	       *GetClass()->GetName(), *AnimConfig->GetPathName());
+}
+#endif
+
+void UALSCharacterAnimInstance::BindAnimConfig()
+{
+	ActiveAnimConfig = AnimConfig ? AnimConfig : GetDefault<UALSAnimConfig>();
+	Config = &ActiveAnimConfig->Config;
+	TurnInPlace = &ActiveAnimConfig->TurnInPlace;
+	RotateInPlace = &ActiveAnimConfig->RotateInPlace;
+	SignificanceSettings = &ActiveAnimConfig->SignificanceSettings;
+}
 
 void UALSCharacterAnimInstance::NativeInitializeAnimation()
 {
 	Super::NativeInitializeAnimation();
 	Character = Cast<AALSBaseCharacter>(TryGetPawnOwner());
+	bServerAnimMode = Character && Character->IsServerAnimMode();
+	CurveCache.Initialize(CurrentSkeleton);
+	InitializeFromAnimConfig();
+}
+
+void UALSCharacterAnimInstance::InitializeFromAnimConfig()
+{
+	BindAnimConfig();
+	CurveCache.ChangeTolerance = Config->DirtyTrackingTolerance;
+
+	DiagonalScaleAmountLUT.Bind(ActiveAnimConfig->DiagonalScaleAmountCurve);
+	StrideBlend_N_WalkLUT.Bind(ActiveAnimConfig->StrideBlend_N_Walk);
+	StrideBlend_N_RunLUT.Bind(ActiveAnimConfig->StrideBlend_N_Run);
+	StrideBlend_C_WalkLUT.Bind(ActiveAnimConfig->StrideBlend_C_Walk);
+	LandPredictionLUT.Bind(ActiveAnimConfig->LandPredictionCurve);
+	LeanInAirLUT.Bind(ActiveAnimConfig->LeanInAirCurve);
+	YawOffset_FBLUT.Bind(ActiveAnimConfig->YawOffset_FB);
+	YawOffset_LRLUT.Bind(ActiveAnimConfig->YawOffset_LR);
+}
+
+void UALSCharacterAnimInstance::LogMemoryLayout()
+{
+	const UALSCharacterAnimInstance* Instance = GetDefault<UALSCharacterAnimInstance>();
+	auto Offset = [Instance](const void* Member)
+	{
+		return static_cast<int32>(static_cast<const uint8*>(Member) - reinterpret_cast<const uint8*>(Instance));
+	};
+
+	// Per update part spans from the first anim graph value to the last private value every update touches
+	const int32 UpdateBegin = Offset(&Instance->CharacterInformation);
+	const int32 UpdateEnd = Offset(&Instance->bCanPlayDynamicTransition) + sizeof(bool);
+
+	UE_LOG(LogALS, Display, TEXT("UALSCharacterAnimInstance: %d bytes, %d of them UAnimInstance"),
+	       static_cast<int32>(sizeof(UALSCharacterAnimInstance)), static_cast<int32>(sizeof(UAnimInstance)));
+	UE_LOG(LogALS, Display, TEXT("Values every update touches: offset %d, %d bytes"), UpdateBegin,
+	       UpdateEnd - UpdateBegin);
+	UE_LOG(LogALS, Display, TEXT("Shared through UALSAnimConfig: %d bytes per anim class instead of per instance"),
+	       static_cast<int32>(sizeof(FALSAnimConfiguration) + sizeof(FALSAnimTurnInPlace) +
+		       sizeof(FALSAnimRotateInPlace) + sizeof(FALSAnimSignificanceSettings) + 10 * sizeof(UObject*)));
+	UE_LOG(LogALS, Display, TEXT("State wrappers: movement state %d, rotation mode %d, gait %d, stance %d, "
+		       "overlay state %d bytes"), static_cast<int32>(sizeof(FALSMovementState)),
+	       static_cast<int32>(sizeof(FALSRotationMode)), static_cast<int32>(sizeof(FALSGait)),
+	       static_cast<int32>(sizeof(FALSStance)), static_cast<int32>(sizeof(FALSOverlayState)));
+}
+
+UALSAnimConfig* UALSCharacterAnimInstance::GetActiveAnimConfig() const
+{
+	// Also read from anim graphs of instances that were not initialized yet, e.g. in the editor
+	const UALSAnimConfig* Active = ActiveAnimConfig ? ActiveAnimConfig : AnimConfig;
+	return const_cast<UALSAnimConfig*>(Active ? Active : GetDefault<UALSAnimConfig>());
+}
+
+FALSAnimConfiguration UALSCharacterAnimInstance::GetConfig() const
+{
+	return GetActiveAnimConfig()->Config;
+}
+
+FALSAnimTurnInPlace UALSCharacterAnimInstance::GetTurnInPlaceValues() const
+{
+	return GetActiveAnimConfig()->TurnInPlace;
+}
+
+FALSAnimRotateInPlace UALSCharacterAnimInstance::GetRotateInPlace() const
+{
+	return GetActiveAnimConfig()->RotateInPlace;
+}
+
+namespace ALSAnimLayout
+{
+	FAutoConsoleCommand LogCommand(
+		TEXT("als.AnimLayout"),
+		TEXT("Print the memory layout of the ALS character anim instance."),
+		FConsoleCommandDelegate::CreateStatic(&UALSCharacterAnimInstance::LogMemoryLayout));
+}
+
+void UALSCharacterAnimInstance::NativePostEvaluateAnimation()
+{
+	Super::NativePostEvaluateAnimation();
+
+	// Curve cache is filled by the proxy during the evaluation
+	PublishGameplayCurves();
+}
+
+void UALSCharacterAnimInstance::ResetCachedCurves()
+{
+	CurveCache.Reset();
+	PublishGameplayCurves();
+}
+
+void UALSCharacterAnimInstance::PublishGameplayCurves()
+{
+	FALSGameplayCurves& Curves = GameplayCurves.GetBack();
+	Curves.YawOffset = CurveCache.Get(EALSAnimCurve::YawOffset);
+	Curves.RotationAmount = CurveCache.Get(EALSAnimCurve::RotationAmount);
+	Curves.Frame = GFrameCounter;
+	GameplayCurves.Publish();
+}
+
+void UALSCharacterAnimInstance::OnDeadline(FALSDeadline& Deadline)
+{
+	if (&Deadline == &OnJumpedDeadline)
+	{
+		OnJumpedDelay();
+	}
+	else if (&Deadline == &OnPivotDeadline)
+	{
+		OnPivotDelay();
+	}
+	else if (&Deadline == &PlayDynamicTransitionDeadline)
+	{
+		PlayDynamicTransitionDelay();
+	}
 }
 
 void UALSCharacterAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 {
 	Super::NativeUpdateAnimation(DeltaSeconds);
 
-	if (!Character || DeltaSeconds == 0.0f)
+	GameThreadValues.bValid = Character && DeltaSeconds != 0.0f;
+	if (!GameThreadValues.bValid)
 	{
 		// Fix character looking right on editor
 		RotationMode = EALSRotationMode::VelocityDirection;
@@ -32,15 +355,35 @@ void UALSCharacterAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 		return;
 	}
 
+	ApplyFrameState(Character->GetFrameState());
+
+	UpdateSignificanceTier(DeltaSeconds);
+	ALSSignificanceStats::CountTier(SignificanceTier);
+	FScopeCycleCounter TierCycleCounter(ALSSignificanceStats::GetUpdateStatId(SignificanceTier));
+
+	UpdatePoseCacheNodeInputs();
+	if (SignificanceTier == EALSAnimSignificance::PoseCache || SignificanceTier == EALSAnimSignificance::Frozen)
+	{
+		// Nothing of the ALS update runs, values stay as they were when the character left the ALS graph
+		GameThreadValues.bValid = false;
+		return;
+	}
+
 	// Update rest of character information. Others are reflected into anim bp when they're set inside character class
 	CharacterInformation.Velocity = Character->GetCharacterMovement()->Velocity;
 	CharacterInformation.MovementInput = Character->GetMovementInput();
 	CharacterInformation.AimingRotation = Character->GetAimingRotation();
 	CharacterInformation.CharacterActorRotation = Character->GetActorRotation();
 
-	UpdateAimingValues(DeltaSeconds);
-	UpdateLayerValues();
-	UpdateFootIK(DeltaSeconds);
+	UpdateGameThreadValues();
+	GameThreadValues.bHasKernelOutput = KernelOutputFrame == GFrameCounter;
+
+	// Calculate the Aiming angle here as well, Turn In Place check below needs it and has to stay on game thread
+	// because of montage playback.
+	FRotator Delta = CharacterInformation.AimingRotation - CharacterInformation.CharacterActorRotation;
+	Delta.Normalize();
+	AimingValues.AimingAngle.X = Delta.Yaw;
+	AimingValues.AimingAngle.Y = Delta.Pitch;
 
 	if (MovementState.Grounded())
 	{
@@ -51,11 +394,309 @@ void UALSCharacterAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 		if (bPrevShouldMove == false && Grounded.bShouldMove)
 		{
 			// Do When Starting To Move
-			TurnInPlaceValues.ElapsedDelayTime = 0.0f;
+			TurnInPlaceDelayTime = 0.0f;
 			Grounded.bRotateL = false;
 			Grounded.bRotateR = false;
 		}
 
+		if (!Grounded.bShouldMove)
+		{
+			// Do While Not Moving
+			if (CanTurnInPlace() && GetTierSettings().bTurnInPlace)
+			{
+				TurnInPlaceCheck(DeltaSeconds);
+			}
+			else
+			{
+				TurnInPlaceDelayTime = 0.0f;
+			}
+			if (CanDynamicTransition() && GetTierSettings().bDynamicTransitions && !bServerAnimMode)
+			{
+				DynamicTransitionCheck();
+			}
+		}
+	}
+}
+
+void UALSCharacterAnimInstance::ApplyFrameState(const FALSCharacterFrameState& State)
+{
+	CharacterInformation.Acceleration = State.Acceleration;
+	CharacterInformation.Speed = State.Speed;
+	CharacterInformation.MovementInputAmount = State.MovementInputAmount;
+	CharacterInformation.AimYawRate = State.AimYawRate;
+	CharacterInformation.bIsMoving = State.bIsMoving;
+	CharacterInformation.bHasMovementInput = State.bHasMovementInput;
+	CharacterInformation.PrevMovementState = State.PrevMovementState;
+	CharacterInformation.ViewMode = State.ViewMode;
+	MovementState = State.MovementState;
+	MovementAction = State.MovementAction;
+	RotationMode = State.RotationMode;
+	Gait = State.Gait;
+	Stance = State.Stance;
+	OverlayState = State.OverlayState;
+}
+
+void UALSCharacterAnimInstance::UpdateSignificanceTier(float DeltaSeconds)
+{
+	if (!SignificanceSettings->bEnableSignificanceTiers)
+	{
+		SignificanceTier = EALSAnimSignificance::Full;
+	}
+	else if (GetWorld()->GetTimeSeconds() >= NextSignificanceUpdateTime)
+	{
+		NextSignificanceUpdateTime = GetWorld()->GetTimeSeconds() + SignificanceSettings->SignificanceUpdateInterval;
+
+		const float Significance = Character->GetAnimSignificance();
+		if (Significance >= SignificanceSettings->MinFullSignificance)
+		{
+			SignificanceTier = EALSAnimSignificance::Full;
+		}
+		else if (Significance >= SignificanceSettings->MinReducedSignificance)
+		{
+			SignificanceTier = EALSAnimSignificance::Reduced;
+		}
+		else if (Significance >= SignificanceSettings->MinMinimalSignificance)
+		{
+			SignificanceTier = EALSAnimSignificance::Minimal;
+		}
+		else if (SignificanceSettings->bUsePoseCache && Significance >= SignificanceSettings->MinPoseCacheSignificance)
+		{
+			SignificanceTier = EALSAnimSignificance::PoseCache;
+		}
+		else
+		{
+			SignificanceTier = EALSAnimSignificance::Frozen;
+		}
+	}
+
+	// Blend features in and out, so a tier change doesn't pop
+	const FALSAnimTierSettings& Tier = GetTierSettings();
+	const float BlendSpeed = SignificanceSettings->TierBlendSpeed;
+	GameThreadValues.FootIKTraceWeight = FMath::FInterpConstantTo(GameThreadValues.FootIKTraceWeight,
+	                                                              Tier.bFootIKTraces ? 1.0f : 0.0f,
+	                                                              DeltaSeconds, BlendSpeed);
+	GameThreadValues.LandPredictionWeight = FMath::FInterpConstantTo(GameThreadValues.LandPredictionWeight,
+	                                                                 Tier.bLandPrediction ? 1.0f : 0.0f,
+	                                                                 DeltaSeconds, BlendSpeed);
+	GameThreadValues.AimSmoothingWeight = FMath::FInterpConstantTo(GameThreadValues.AimSmoothingWeight,
+	                                                               Tier.bAimSmoothing ? 1.0f : 0.0f,
+	                                                               DeltaSeconds, BlendSpeed);
+}
+
+const FALSAnimTierSettings& UALSCharacterAnimInstance::GetTierSettings() const
+{
+	switch (SignificanceTier)
+	{
+	case EALSAnimSignificance::Reduced:
+		return SignificanceSettings->Reduced;
+	case EALSAnimSignificance::Minimal:
+	case EALSAnimSignificance::PoseCache:
+	case EALSAnimSignificance::Frozen:
+		return SignificanceSettings->Minimal;
+	default:
+		return SignificanceSettings->Full;
+	}
+}
+
+FALSBoneCache& UALSCharacterAnimInstance::GetBoneCache()
+{
+	BoneCache.Update(*GetOwningComponent());
+	return BoneCache;
+}
+
+bool UALSCharacterAnimInstance::GetKernelInput(FALSAnimKernelInput& OutInput) const
+{
+	// Tiers without the ALS update don't read the kernel output
+	if (SignificanceTier == EALSAnimSignificance::PoseCache || SignificanceTier == EALSAnimSignificance::Frozen)
+	{
+		return false;
+	}
+
+	// Kernels only unrotate by yaw
+	const FRotator Rotation = Character ? Character->GetActorRotation() : FRotator::ZeroRotator;
+	if (!Character || !FMath::IsNearlyZero(Rotation.Pitch) || !FMath::IsNearlyZero(Rotation.Roll))
+	{
+		return false;
+	}
+
+	// Kernels run before the anim update copies the frame state
+	const FALSCharacterFrameState State = Character->GetFrameState();
+	const UCharacterMovementComponent* CharacterMovement = Character->GetCharacterMovement();
+	OutInput.Velocity = CharacterMovement->Velocity;
+	OutInput.Acceleration = State.Acceleration;
+	OutInput.Yaw = Rotation.Yaw;
+	OutInput.Speed = State.Speed;
+	OutInput.GaitCurve = CurveCache.Get(EALSAnimCurve::W_Gait);
+	OutInput.MeshScaleZ = GetOwningComponent()->GetComponentScale().Z;
+	OutInput.MaxAcceleration = CharacterMovement->GetMaxAcceleration();
+	OutInput.MaxBrakingDeceleration = CharacterMovement->GetMaxBrakingDeceleration();
+	OutInput.AnimatedWalkSpeed = Config->AnimatedWalkSpeed;
+	OutInput.AnimatedRunSpeed = Config->AnimatedRunSpeed;
+	OutInput.AnimatedSprintSpeed = Config->AnimatedSprintSpeed;
+	OutInput.AnimatedCrouchSpeed = Config->AnimatedCrouchSpeed;
+	return true;
+}
+
+void UALSCharacterAnimInstance::SetKernelOutput(const FALSAnimKernelOutput& Output)
+{
+	KernelOutput = Output;
+	KernelOutputFrame = GFrameCounter;
+}
+
+void UALSCharacterAnimInstance::CalculateKernelValues(FALSAnimKernelOutput& OutOutput)
+{
+	const bool bHasKernelOutput = GameThreadValues.bHasKernelOutput;
+	GameThreadValues.bHasKernelOutput = false;
+	OutOutput.VelocityBlend = CalculateVelocityBlend();
+	OutOutput.RelativeAcceleration = CalculateRelativeAccelerationAmount();
+	OutOutput.StandingSpeedRate = CalculateStandingPlayRate();
+	OutOutput.CrouchingSpeedRate = CalculateCrouchingPlayRate();
+	OutOutput.AirLean = CalculateAirLeanAmount();
+	GameThreadValues.bHasKernelOutput = bHasKernelOutput;
+}
+
+FAnimInstanceProxy* UALSCharacterAnimInstance::CreateAnimInstanceProxy()
+{
+	return new FALSAnimInstanceProxy(this);
+}
+
+void UALSCharacterAnimInstance::DestroyAnimInstanceProxy(FAnimInstanceProxy* InProxy)
+{
+	delete InProxy;
+}
+
+void UALSCharacterAnimInstance::UpdateGameThreadValues()
+{
+	const UCharacterMovementComponent* CharacterMovement = Character->GetCharacterMovement();
+	USkeletalMeshComponent* OwnerComp = GetOwningComponent();
+	BoneCache.Update(*OwnerComp);
+
+	GameThreadValues.bIsMovingOnGround = CharacterMovement->IsMovingOnGround();
+	GameThreadValues.bIsAutonomousProxy = Character->GetLocalRole() == ROLE_AutonomousProxy;
+	GameThreadValues.MaxAcceleration = CharacterMovement->GetMaxAcceleration();
+	GameThreadValues.MaxBrakingDeceleration = CharacterMovement->GetMaxBrakingDeceleration();
+	GameThreadValues.LastUpdateRotation = CharacterMovement->GetLastUpdateRotation();
+	GameThreadValues.MeshScaleZ = OwnerComp->GetComponentScale().Z;
+	GameThreadValues.MeshRotation = OwnerComp->GetComponentRotation();
+	GameThreadValues.UpdateRateScale = 1.f / OwnerComp->AnimUpdateRateParams->UpdateRate;
+	if (bServerAnimMode)
+	{
+		// Foot IK, land prediction and ragdoll values only drive cosmetic parts of the pose
+		return;
+	}
+
+	if (!Config->bUseNativeFootIKNode)
+	{
+		GameThreadValues.IKFoot_L = BoneCache.GetTransform(*OwnerComp, EALSBone::IKFoot_L, RTS_Component);
+		GameThreadValues.IKFoot_R = BoneCache.GetTransform(*OwnerComp, EALSBone::IKFoot_R, RTS_Component);
+	}
+
+	// Async foot traces are one frame behind, which is not acceptable after a teleport or a movement mode change
+	bForceSyncFootIKTraces = CharacterMovement->bJustTeleported ||
+		CharacterMovement->MovementMode != PrevMovementMode;
+	PrevMovementMode = CharacterMovement->MovementMode;
+
+	// Traces of lower tiers run at an interval, the last results are kept in between
+	const FALSAnimTierSettings& Tier = GetTierSettings();
+	const bool bTraceThisUpdate = ++UpdatesSinceTrace >= Tier.TraceInterval || bForceSyncFootIKTraces;
+	if (bTraceThisUpdate)
+	{
+		UpdatesSinceTrace = 0;
+	}
+
+	// Scene queries must be issued from game thread, results are consumed by the thread safe update
+	const bool bFootIKTraces = Tier.bFootIKTraces || GameThreadValues.FootIKTraceWeight > 0.0f;
+	if (!MovementState.InAir() && !MovementState.Ragdoll() && bFootIKTraces)
+	{
+		if (bTraceThisUpdate)
+		{
+			GameThreadValues.FootOffset_L_Target = FVector::ZeroVector;
+			GameThreadValues.FootOffset_R_Target = FVector::ZeroVector;
+			GameThreadValues.FootOffset_L_RotationTarget = FRotator::ZeroRotator;
+			GameThreadValues.FootOffset_R_RotationTarget = FRotator::ZeroRotator;
+			TraceFootOffsets(EALSAnimCurve::Enable_FootIK_L, EALSBone::IKFoot_L, FootIKTraceHandle_L,
+			                 FootIKTraceCache_L, GameThreadValues.FootOffset_L_Target,
+			                 GameThreadValues.FootOffset_L_RotationTarget);
+			TraceFootOffsets(EALSAnimCurve::Enable_FootIK_R, EALSBone::IKFoot_R, FootIKTraceHandle_R,
+			                 FootIKTraceCache_R, GameThreadValues.FootOffset_R_Target,
+			                 GameThreadValues.FootOffset_R_RotationTarget);
+		}
+	}
+	else
+	{
+		GameThreadValues.FootOffset_L_Target = FVector::ZeroVector;
+		GameThreadValues.FootOffset_R_Target = FVector::ZeroVector;
+		GameThreadValues.FootOffset_L_RotationTarget = FRotator::ZeroRotator;
+		GameThreadValues.FootOffset_R_RotationTarget = FRotator::ZeroRotator;
+		FootIKTraceHandle_L.Invalidate();
+		FootIKTraceHandle_R.Invalidate();
+		FootIKTraceCache_L.bValid = false;
+		FootIKTraceCache_R.bValid = false;
+	}
+
+	if (Config->bUseNativeFootIKNode)
+	{
+		UpdateFootIKNodeInputs();
+	}
+
+	const bool bLandPrediction = Tier.bLandPrediction || GameThreadValues.LandPredictionWeight > 0.0f;
+	if (!MovementState.InAir() || !bLandPrediction)
+	{
+		GameThreadValues.LandPredictionTime = -1.0f;
+		LandPredictionCache.bValid = false;
+		LandPredictionTraceHandles.Reset();
+	}
+	else if (Config->bUseAnalyticLandPrediction)
+	{
+		UpdateAnalyticLandPrediction();
+	}
+	else if (bTraceThisUpdate)
+	{
+		GameThreadValues.LandPredictionTime = -1.0f;
+		TraceLandPrediction();
+	}
+
+	if (MovementState.Ragdoll())
+	{
+		const FBodyInstance* RootBody = BoneCache.GetBodyInstance(*OwnerComp, EALSBone::Root);
+		GameThreadValues.RagdollVelocity = RootBody ? RootBody->GetUnrealWorldVelocity().Size() : 0.0f;
+	}
+}
+
+void UALSCharacterAnimInstance::NativeThreadSafeUpdateAnimation(float DeltaSeconds)
+{
+	if (!GameThreadValues.bValid)
+	{
+		return;
+	}
+
+	if (RecordingTrack)
+	{
+		FALSAnimRecorder::RecordUpdateStart(*this, DeltaSeconds);
+	}
+
+	FScopeCycleCounter TierCycleCounter(ALSSignificanceStats::GetUpdateStatId(SignificanceTier));
+
+	// Continue interpolating from the values of the last update, not from their extrapolation
+	RestoreExtrapolatedValues();
+
+	// The server anim mode skips aiming, layering and foot IK, the base layer only needs the grounded values
+	if (!bServerAnimMode)
+	{
+		UpdateAimingValues(DeltaSeconds);
+		if (!Config->bUseDirtyTracking ||
+			ALSDirtyTracking::Count(CurveCache.HasChanged(ALSDirtyTracking::LayerCurves)))
+		{
+			UpdateLayerValues();
+		}
+		if (!Config->bUseNativeFootIKNode)
+		{
+			UpdateFootIK(DeltaSeconds);
+		}
+	}
+
+	if (MovementState.Grounded())
+	{
 		if (Grounded.bShouldMove)
 		{
 			// Do While Moving
@@ -74,20 +715,12 @@ void UALSCharacterAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 				Grounded.bRotateL = false;
 				Grounded.bRotateR = false;
 			}
-			if (CanTurnInPlace())
-			{
-				TurnInPlaceCheck(DeltaSeconds);
-			}
-			else
-			{
-				TurnInPlaceValues.ElapsedDelayTime = 0.0f;
-			}
-			if (CanDynamicTransition())
-			{
-				DynamicTransitionCheck();
-			}
 		}
 	}
+	else if (bServerAnimMode)
+	{
+		// Curves are only read by the character while grounded
+	}
 	else if (MovementState.InAir())
 	{
 		// Do While InAir
@@ -98,6 +731,85 @@ void UALSCharacterAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 		// Do While Ragdolling
 		UpdateRagdollValues();
 	}
+
+	if (Config->bExtrapolateSkippedFrames && GameThreadValues.UpdateRateScale < 1.0f && !bServerAnimMode)
+	{
+		ExtrapolateSkippedFrames();
+	}
+
+	// Curve changes are collected until the next update reads them
+	CurveCache.ClearChanged();
+
+	if (RecordingTrack)
+	{
+		FALSAnimRecorder::RecordUpdateEnd(*this);
+	}
+}
+
+void UALSCharacterAnimInstance::ExtrapolateSkippedFrames()
+{
+	// Values change at the rate of the last update, the next update is 1 / UpdateRateScale frames away
+	const float Lead = Config->ExtrapolationAmount * (1.0f - GameThreadValues.UpdateRateScale);
+	const FALSAnimExtrapolationState Last = Extrapolation;
+
+	Extrapolation.bApplied = true;
+	Extrapolation.VelocityBlend = VelocityBlend;
+	Extrapolation.LeanAmount = LeanAmount;
+	Extrapolation.SmoothedAimingRotation = AimingValues.SmoothedAimingRotation;
+	Extrapolation.SmoothedAimingAngle = SmoothedAimingAngle;
+	Extrapolation.FootOffset_L_Location = FootIKValues.FootOffset_L_Location;
+	Extrapolation.FootOffset_R_Location = FootIKValues.FootOffset_R_Location;
+	Extrapolation.FootOffset_L_Rotation = FootIKValues.FootOffset_L_Rotation;
+	Extrapolation.FootOffset_R_Rotation = FootIKValues.FootOffset_R_Rotation;
+	if (!Last.bApplied)
+	{
+		// No rate known yet
+		return;
+	}
+
+	VelocityBlend.F = FMath::Clamp(VelocityBlend.F + (VelocityBlend.F - Last.VelocityBlend.F) * Lead, 0.0f, 1.0f);
+	VelocityBlend.B = FMath::Clamp(VelocityBlend.B + (VelocityBlend.B - Last.VelocityBlend.B) * Lead, 0.0f, 1.0f);
+	VelocityBlend.L = FMath::Clamp(VelocityBlend.L + (VelocityBlend.L - Last.VelocityBlend.L) * Lead, 0.0f, 1.0f);
+	VelocityBlend.R = FMath::Clamp(VelocityBlend.R + (VelocityBlend.R - Last.VelocityBlend.R) * Lead, 0.0f, 1.0f);
+	LeanAmount.LR += (LeanAmount.LR - Last.LeanAmount.LR) * Lead;
+	LeanAmount.FB += (LeanAmount.FB - Last.LeanAmount.FB) * Lead;
+
+	const FRotator AimingDelta = (AimingValues.SmoothedAimingRotation - Last.SmoothedAimingRotation).GetNormalized();
+	AimingValues.SmoothedAimingRotation = (AimingValues.SmoothedAimingRotation + AimingDelta * Lead).GetNormalized();
+
+	// The graph reads the angle, derive it again from the extrapolated rotation as UpdateAimingValues does
+	FRotator Delta = AimingValues.SmoothedAimingRotation - CharacterInformation.CharacterActorRotation;
+	Delta.Normalize();
+	SmoothedAimingAngle.X = Delta.Yaw;
+	SmoothedAimingAngle.Y = Delta.Pitch;
+
+	FootIKValues.FootOffset_L_Location += (FootIKValues.FootOffset_L_Location - Last.FootOffset_L_Location) * Lead;
+	FootIKValues.FootOffset_R_Location += (FootIKValues.FootOffset_R_Location - Last.FootOffset_R_Location) * Lead;
+	FootIKValues.FootOffset_L_Rotation = (FootIKValues.FootOffset_L_Rotation +
+		(FootIKValues.FootOffset_L_Rotation - Last.FootOffset_L_Rotation).GetNormalized() * Lead).GetNormalized();
+	FootIKValues.FootOffset_R_Rotation = (FootIKValues.FootOffset_R_Rotation +
+		(FootIKValues.FootOffset_R_Rotation - Last.FootOffset_R_Rotation).GetNormalized() * Lead).GetNormalized();
+}
+
+void UALSCharacterAnimInstance::RestoreExtrapolatedValues()
+{
+	if (!Extrapolation.bApplied)
+	{
+		return;
+	}
+
+	VelocityBlend = Extrapolation.VelocityBlend;
+	LeanAmount = Extrapolation.LeanAmount;
+	AimingValues.SmoothedAimingRotation = Extrapolation.SmoothedAimingRotation;
+	SmoothedAimingAngle = Extrapolation.SmoothedAimingAngle;
+	FootIKValues.FootOffset_L_Location = Extrapolation.FootOffset_L_Location;
+	FootIKValues.FootOffset_R_Location = Extrapolation.FootOffset_R_Location;
+	FootIKValues.FootOffset_L_Rotation = Extrapolation.FootOffset_L_Rotation;
+	FootIKValues.FootOffset_R_Rotation = Extrapolation.FootOffset_R_Rotation;
+	if (!Config->bExtrapolateSkippedFrames || GameThreadValues.UpdateRateScale >= 1.0f)
+	{
+		Extrapolation.bApplied = false;
+	}
 }
 
 void UALSCharacterAnimInstance::PlayTransition(const FALSDynamicMontageParams& Parameters)
@@ -124,11 +836,7 @@ void UALSCharacterAnimInstance::PlayDynamicTransition(float ReTriggerDelay, FALS
 		// Play Dynamic Additive Transition Animation
 		PlayTransition(Parameters);
 
-		UWorld* World = GetWorld();
-		check(World);
-		World->GetTimerManager().SetTimer(PlayDynamicTransitionTimer, this,
-		                                  &UALSCharacterAnimInstance::PlayDynamicTransitionDelay,
-		                                  ReTriggerDelay, false);
+		UALSDeadlineSubsystem::Schedule(this, PlayDynamicTransitionDeadline, ReTriggerDelay);
 	}
 }
 
@@ -148,12 +856,12 @@ bool UALSCharacterAnimInstance::CanTurnInPlace() const
 {
 	return RotationMode.LookingDirection() &&
 		CharacterInformation.ViewMode == EALSViewMode::ThirdPerson &&
-		GetCurveValue(FName(TEXT("Enable_Transition"))) >= 0.99f;
+		CurveCache.Get(EALSAnimCurve::Enable_Transition) >= 0.99f;
 }
 
 bool UALSCharacterAnimInstance::CanDynamicTransition() const
 {
-	return GetCurveValue(FName(TEXT("Enable_Transition"))) >= 0.99f;
+	return CurveCache.Get(EALSAnimCurve::Enable_Transition) >= 0.99f;
 }
 
 void UALSCharacterAnimInstance::PlayDynamicTransitionDelay()
@@ -177,18 +885,17 @@ void UALSCharacterAnimInstance::UpdateAimingValues(float DeltaSeconds)
 	// Interpolating the rotation before calculating the angle ensures the value is not affected by changes
 	// in actor rotation, allowing slow aiming rotation changes with fast actor rotation changes.
 
-	AimingValues.SmoothedAimingRotation = FMath::RInterpTo(AimingValues.SmoothedAimingRotation,
-	                                                       CharacterInformation.AimingRotation, DeltaSeconds,
-	                                                       Config.SmoothedAimingRotationInterpSpeed);
-
-	// Calculate the Aiming angle and Smoothed Aiming Angle by getting
-	// the delta between the aiming rotation and the actor rotation.
-	FRotator Delta = CharacterInformation.AimingRotation - CharacterInformation.CharacterActorRotation;
-	Delta.Normalize();
-	AimingValues.AimingAngle.X = Delta.Yaw;
-	AimingValues.AimingAngle.Y = Delta.Pitch;
-
-	Delta = AimingValues.SmoothedAimingRotation - CharacterInformation.CharacterActorRotation;
+	// Lower significance tiers fade the smoothing out by speeding up the interpolation, zero speed snaps to target.
+	const float AimingInterpSpeed = GameThreadValues.AimSmoothingWeight > 0.0f
+		                                ? Config->SmoothedAimingRotationInterpSpeed / GameThreadValues.AimSmoothingWeight
+		                                : 0.0f;
+	AimingValues.SmoothedAimingRotation = UALSMathLibrary::RInterpToSubstepped(
+		AimingValues.SmoothedAimingRotation, CharacterInformation.AimingRotation, DeltaSeconds, AimingInterpSpeed,
+		Config->MaxInterpSubstep);
+
+	// Calculate the Smoothed Aiming Angle by getting the delta between the smoothed aiming rotation and the actor rotation.
+	// Aiming Angle itself is calculated on game thread.
+	FRotator Delta = AimingValues.SmoothedAimingRotation - CharacterInformation.CharacterActorRotation;
 	Delta.Normalize();
 	SmoothedAimingAngle.X = Delta.Yaw;
 	SmoothedAimingAngle.Y = Delta.Pitch;
@@ -213,8 +920,9 @@ void UALSCharacterAnimInstance::UpdateAimingValues(float DeltaSeconds)
 		Delta.Normalize();
 		const float InterpTarget = FMath::GetMappedRangeValueClamped({-180.0f, 180.0f}, {0.0f, 1.0f}, Delta.Yaw);
 
-		AimingValues.InputYawOffsetTime = FMath::FInterpTo(AimingValues.InputYawOffsetTime, InterpTarget,
-		                                                   DeltaSeconds, Config.InputYawOffsetInterpSpeed);
+		AimingValues.InputYawOffsetTime = UALSMathLibrary::FInterpToSubstepped(
+			AimingValues.InputYawOffsetTime, InterpTarget, DeltaSeconds, Config->InputYawOffsetInterpSpeed,
+			Config->MaxInterpSubstep);
 	}
 
 	// Separate the Aiming Yaw Angle into 3 separate Yaw Times. These 3 values are used in the Aim Offset behavior
@@ -231,42 +939,46 @@ void UALSCharacterAnimInstance::UpdateAimingValues(float DeltaSeconds)
 void UALSCharacterAnimInstance::UpdateLayerValues()
 {
 	// Get the Aim Offset weight by getting the opposite of the Aim Offset Mask.
-	LayerBlendingValues.EnableAimOffset = FMath::Lerp(1.0f, 0.0f, GetCurveValue(FName(TEXT("Mask_AimOffset"))));
+	LayerBlendingValues.EnableAimOffset = FMath::Lerp(1.0f, 0.0f, CurveCache.Get(EALSAnimCurve::Mask_AimOffset));
+	// Blend and set the Hand IK weights to ensure they only are weighted if allowed by the Arm layers.
+	LayerBlendingValues.EnableHandIK_L = FMath::Lerp(0.0f, CurveCache.Get(EALSAnimCurve::Enable_HandIK_L),
+	                                                 CurveCache.Get(EALSAnimCurve::Layering_Arm_L));
+	LayerBlendingValues.EnableHandIK_R = FMath::Lerp(0.0f, CurveCache.Get(EALSAnimCurve::Enable_HandIK_R),
+	                                                 CurveCache.Get(EALSAnimCurve::Layering_Arm_R));
+
+	if (Config->bUseNativeLayeringNode)
+	{
+		// Rest of the weights are read by the layering node
+		return;
+	}
+
 	// Set the Base Pose weights
-	LayerBlendingValues.BasePose_N = GetCurveValue(FName(TEXT("BasePose_N")));
-	LayerBlendingValues.BasePose_CLF = GetCurveValue(FName(TEXT("BasePose_CLF")));
+	LayerBlendingValues.BasePose_N = CurveCache.Get(EALSAnimCurve::BasePose_N);
+	LayerBlendingValues.BasePose_CLF = CurveCache.Get(EALSAnimCurve::BasePose_CLF);
 	// Set the Additive amount weights for each body part
-	LayerBlendingValues.Spine_Add = GetCurveValue(FName(TEXT("Layering_Spine_Add")));
-	LayerBlendingValues.Head_Add = GetCurveValue(FName(TEXT("Layering_Head_Add")));
-	LayerBlendingValues.Arm_L_Add = GetCurveValue(FName(TEXT("Layering_Arm_L_Add")));
-	LayerBlendingValues.Arm_R_Add = GetCurveValue(FName(TEXT("Layering_Arm_R_Add")));
+	LayerBlendingValues.Spine_Add = CurveCache.Get(EALSAnimCurve::Layering_Spine_Add);
+	LayerBlendingValues.Head_Add = CurveCache.Get(EALSAnimCurve::Layering_Head_Add);
+	LayerBlendingValues.Arm_L_Add = CurveCache.Get(EALSAnimCurve::Layering_Arm_L_Add);
+	LayerBlendingValues.Arm_R_Add = CurveCache.Get(EALSAnimCurve::Layering_Arm_R_Add);
 	// Set the Hand Override weights
-	LayerBlendingValues.Hand_R = GetCurveValue(FName(TEXT("Layering_Hand_R")));
-	LayerBlendingValues.Hand_L = GetCurveValue(FName(TEXT("Layering_Hand_L")));
-	// Blend and set the Hand IK weights to ensure they only are weighted if allowed by the Arm layers.
-	LayerBlendingValues.EnableHandIK_L = FMath::Lerp(0.0f, GetCurveValue(FName(TEXT("Enable_HandIK_L"))),
-	                                                 GetCurveValue(FName(TEXT("Layering_Arm_L"))));
-	LayerBlendingValues.EnableHandIK_R = FMath::Lerp(0.0f, GetCurveValue(FName(TEXT("Enable_HandIK_R"))),
-	                                                 GetCurveValue(FName(TEXT("Layering_Arm_R"))));
+	LayerBlendingValues.Hand_R = CurveCache.Get(EALSAnimCurve::Layering_Hand_R);
+	LayerBlendingValues.Hand_L = CurveCache.Get(EALSAnimCurve::Layering_Hand_L);
 	// Set whether the arms should blend in mesh space or local space.
 	// The Mesh space weight will always be 1 unless the Local Space (LS) curve is fully weighted.
-	LayerBlendingValues.Arm_L_LS = GetCurveValue(FName(TEXT("Layering_Arm_L_LS")));
+	LayerBlendingValues.Arm_L_LS = CurveCache.Get(EALSAnimCurve::Layering_Arm_L_LS);
 	LayerBlendingValues.Arm_L_MS = static_cast<float>(1 - FMath::FloorToInt(LayerBlendingValues.Arm_L_LS));
-	LayerBlendingValues.Arm_R_LS = GetCurveValue(FName(TEXT("Layering_Arm_R_LS")));
+	LayerBlendingValues.Arm_R_LS = CurveCache.Get(EALSAnimCurve::Layering_Arm_R_LS);
 	LayerBlendingValues.Arm_R_MS = static_cast<float>(1 - FMath::FloorToInt(LayerBlendingValues.Arm_R_LS));
 }
 
 void UALSCharacterAnimInstance::UpdateFootIK(float DeltaSeconds)
 {
-	FVector FootOffsetLTarget = FVector::ZeroVector;
-	FVector FootOffsetRTarget = FVector::ZeroVector;
-
 	// Update Foot Locking values.
-	SetFootLocking(DeltaSeconds, FName(TEXT("Enable_FootIK_L")), FName(TEXT("FootLock_L")),
-	               FName(TEXT("ik_foot_l")), FootIKValues.FootLock_L_Alpha, FootIKValues.UseFootLockCurve_L,
+	SetFootLocking(DeltaSeconds, EALSAnimCurve::Enable_FootIK_L, EALSAnimCurve::FootLock_L,
+	               GameThreadValues.IKFoot_L, FootIKValues.FootLock_L_Alpha, FootIKValues.UseFootLockCurve_L,
 	               FootIKValues.FootLock_L_Location, FootIKValues.FootLock_L_Rotation);
-	SetFootLocking(DeltaSeconds, FName(TEXT("Enable_FootIK_R")), FName(TEXT("FootLock_R")),
-	               FName(TEXT("ik_foot_r")), FootIKValues.FootLock_R_Alpha, FootIKValues.UseFootLockCurve_R,
+	SetFootLocking(DeltaSeconds, EALSAnimCurve::Enable_FootIK_R, EALSAnimCurve::FootLock_R,
+	               GameThreadValues.IKFoot_R, FootIKValues.FootLock_R_Alpha, FootIKValues.UseFootLockCurve_R,
 	               FootIKValues.FootLock_R_Location, FootIKValues.FootLock_R_Rotation);
 
 	if (MovementState.InAir())
@@ -278,21 +990,68 @@ void UALSCharacterAnimInstance::UpdateFootIK(float DeltaSeconds)
 	else if (!MovementState.Ragdoll())
 	{
 		// Update all Foot Lock and Foot Offset values when not In Air
-		SetFootOffsets(DeltaSeconds, FName(TEXT("Enable_FootIK_L")), FName(TEXT("ik_foot_l")), FName(TEXT("root")),
-		               FootOffsetLTarget,
+		const float TraceWeight = GameThreadValues.FootIKTraceWeight;
+		const FVector FootOffset_L_Target = GameThreadValues.FootOffset_L_Target * TraceWeight;
+		const FVector FootOffset_R_Target = GameThreadValues.FootOffset_R_Target * TraceWeight;
+		SetFootOffsets(DeltaSeconds, EALSAnimCurve::Enable_FootIK_L, FootOffset_L_Target,
+		               GameThreadValues.FootOffset_L_RotationTarget * TraceWeight,
 		               FootIKValues.FootOffset_L_Location, FootIKValues.FootOffset_L_Rotation);
-		SetFootOffsets(DeltaSeconds, FName(TEXT("Enable_FootIK_R")), FName(TEXT("ik_foot_r")), FName(TEXT("root")),
-		               FootOffsetRTarget,
+		SetFootOffsets(DeltaSeconds, EALSAnimCurve::Enable_FootIK_R, FootOffset_R_Target,
+		               GameThreadValues.FootOffset_R_RotationTarget * TraceWeight,
 		               FootIKValues.FootOffset_R_Location, FootIKValues.FootOffset_R_Rotation);
-		SetPelvisIKOffset(DeltaSeconds, FootOffsetLTarget, FootOffsetRTarget);
+		SetPelvisIKOffset(DeltaSeconds, FootOffset_L_Target, FootOffset_R_Target);
 	}
 }
 
-void UALSCharacterAnimInstance::SetFootLocking(float DeltaSeconds, FName EnableFootIKCurve, FName FootLockCurve,
-                                               FName IKFootBone, float& CurFootLockAlpha, bool& UseFootLockCurve,
+void UALSCharacterAnimInstance::UpdateFootIKNodeInputs()
+{
+	FootIKNodeInputs.bInAir = MovementState.InAir();
+	FootIKNodeInputs.bRagdoll = MovementState.Ragdoll();
+	FootIKNodeInputs.bIsAutonomousProxy = GameThreadValues.bIsAutonomousProxy;
+	FootIKNodeInputs.UpdateRateScale = GameThreadValues.UpdateRateScale;
+	FootIKNodeInputs.LocalVelocity = GameThreadValues.MeshRotation.UnrotateVector(CharacterInformation.Velocity);
+
+	FootIKNodeInputs.RotationDifference = FRotator::ZeroRotator;
+	if (GameThreadValues.bIsMovingOnGround)
+	{
+		FootIKNodeInputs.RotationDifference =
+			CharacterInformation.CharacterActorRotation - GameThreadValues.LastUpdateRotation;
+		FootIKNodeInputs.RotationDifference.Normalize();
+	}
+
+	const float TraceWeight = GameThreadValues.FootIKTraceWeight;
+	FootIKNodeInputs.FootOffset_L_Target = GameThreadValues.FootOffset_L_Target * TraceWeight;
+	FootIKNodeInputs.FootOffset_R_Target = GameThreadValues.FootOffset_R_Target * TraceWeight;
+	FootIKNodeInputs.FootOffset_L_RotationTarget = GameThreadValues.FootOffset_L_RotationTarget * TraceWeight;
+	FootIKNodeInputs.FootOffset_R_RotationTarget = GameThreadValues.FootOffset_R_RotationTarget * TraceWeight;
+}
+
+void UALSCharacterAnimInstance::UpdatePoseCacheNodeInputs()
+{
+	PoseCacheNodeInputs.bActive = SignificanceTier == EALSAnimSignificance::PoseCache;
+	if (!PoseCacheNodeInputs.bActive)
+	{
+		return;
+	}
+
+	// The ALS update doesn't run in this tier, read what the cached cycles are blended by straight from the character
+	const FVector Velocity = Character->GetCharacterMovement()->Velocity;
+	PoseCacheNodeInputs.Speed = Velocity.Size2D();
+	PoseCacheNodeInputs.Direction = 0.0f;
+	if (PoseCacheNodeInputs.Speed > KINDA_SMALL_NUMBER)
+	{
+		PoseCacheNodeInputs.Direction =
+			FRotator::NormalizeAxis(Velocity.Rotation().Yaw - Character->GetActorRotation().Yaw);
+	}
+}
+
+void UALSCharacterAnimInstance::SetFootLocking(float DeltaSeconds, EALSAnimCurve EnableFootIKCurve,
+                                               EALSAnimCurve FootLockCurve,
+                                               const FTransform& IKFootTransform, float& CurFootLockAlpha,
+                                               bool& UseFootLockCurve,
                                                FVector& CurFootLockLoc, FRotator& CurFootLockRot)
 {
-	if (GetCurveValue(EnableFootIKCurve) <= 0.0f)
+	if (CurveCache.Get(EnableFootIKCurve) <= 0.0f)
 	{
 		return;
 	}
@@ -302,13 +1061,13 @@ void UALSCharacterAnimInstance::SetFootLocking(float DeltaSeconds, FName EnableF
 
 	if (UseFootLockCurve)
 	{
-		UseFootLockCurve = FMath::Abs(GetCurveValue(FName(TEXT("RotationAmount")))) <= 0.001f ||
-			Character->GetLocalRole() != ROLE_AutonomousProxy;
-		FootLockCurveVal = GetCurveValue(FootLockCurve) * (1.f / GetSkelMeshComponent()->AnimUpdateRateParams->UpdateRate);
+		UseFootLockCurve = FMath::Abs(CurveCache.Get(EALSAnimCurve::RotationAmount)) <= 0.001f ||
+			!GameThreadValues.bIsAutonomousProxy;
+		FootLockCurveVal = CurveCache.Get(FootLockCurve) * GameThreadValues.UpdateRateScale;
 	}
 	else
 	{
-		UseFootLockCurve = GetCurveValue(FootLockCurve) >= 0.99f;
+		UseFootLockCurve = CurveCache.Get(FootLockCurve) >= 0.99f;
 		FootLockCurveVal = 0.0f;
 	}
 
@@ -322,10 +1081,8 @@ void UALSCharacterAnimInstance::SetFootLocking(float DeltaSeconds, FName EnableF
 	// Step 3: If the Foot Lock curve equals 1, save the new lock location and rotation in component space as the target.
 	if (CurFootLockAlpha >= 0.99f)
 	{
-		const FTransform& OwnerTransform =
-			GetOwningComponent()->GetSocketTransform(IKFootBone, RTS_Component);
-		CurFootLockLoc = OwnerTransform.GetLocation();
-		CurFootLockRot = OwnerTransform.Rotator();
+		CurFootLockLoc = IKFootTransform.GetLocation();
+		CurFootLockRot = IKFootTransform.Rotator();
 	}
 
 	// Step 4: If the Foot Lock Alpha has a weight,
@@ -341,16 +1098,15 @@ void UALSCharacterAnimInstance::SetFootLockOffsets(float DeltaSeconds, FVector&
 	FRotator RotationDifference = FRotator::ZeroRotator;
 	// Use the delta between the current and last updated rotation to find how much the foot should be rotated
 	// to remain planted on the ground.
-	if (Character->GetCharacterMovement()->IsMovingOnGround())
+	if (GameThreadValues.bIsMovingOnGround)
 	{
-		RotationDifference = CharacterInformation.CharacterActorRotation - Character->GetCharacterMovement()->
-			GetLastUpdateRotation();
+		RotationDifference = CharacterInformation.CharacterActorRotation - GameThreadValues.LastUpdateRotation;
 		RotationDifference.Normalize();
 	}
 
 	// Get the distance traveled between frames relative to the mesh rotation
 	// to find how much the foot should be offset to remain planted on the ground.
-	const FVector& LocationDifference = GetOwningComponent()->GetComponentRotation().UnrotateVector(
+	const FVector& LocationDifference = GameThreadValues.MeshRotation.UnrotateVector(
 		CharacterInformation.Velocity * DeltaSeconds);
 
 	// Subtract the location difference from the current local location and rotate
@@ -368,7 +1124,7 @@ void UALSCharacterAnimInstance::SetPelvisIKOffset(float DeltaSeconds, FVector Fo
 {
 	// Calculate the Pelvis Alpha by finding the average Foot IK weight. If the alpha is 0, clear the offset.
 	FootIKValues.PelvisAlpha =
-		(GetCurveValue(FName(TEXT("Enable_FootIK_L"))) + GetCurveValue(FName(TEXT("Enable_FootIK_R")))) / 2.0f;
+		(CurveCache.Get(EALSAnimCurve::Enable_FootIK_L) + CurveCache.Get(EALSAnimCurve::Enable_FootIK_R)) / 2.0f;
 
 	if (FootIKValues.PelvisAlpha > 0.0f)
 	{
@@ -379,7 +1135,8 @@ void UALSCharacterAnimInstance::SetPelvisIKOffset(float DeltaSeconds, FVector Fo
 		//Interpolate at different speeds based on whether the new target is above or below the current one.
 		const float InterpSpeed = PelvisTarget.Z > FootIKValues.PelvisOffset.Z ? 10.0f : 15.0f;
 		FootIKValues.PelvisOffset =
-			FMath::VInterpTo(FootIKValues.PelvisOffset, PelvisTarget, DeltaSeconds, InterpSpeed);
+			UALSMathLibrary::VInterpToSubstepped(FootIKValues.PelvisOffset, PelvisTarget, DeltaSeconds, InterpSpeed,
+			                                     Config->MaxInterpSubstep);
 	}
 	else
 	{
@@ -390,85 +1147,148 @@ void UALSCharacterAnimInstance::SetPelvisIKOffset(float DeltaSeconds, FVector Fo
 void UALSCharacterAnimInstance::ResetIKOffsets(float DeltaSeconds)
 {
 	// Interp Foot IK offsets back to 0
-	FootIKValues.FootOffset_L_Location = FMath::VInterpTo(FootIKValues.FootOffset_L_Location,
-	                                                      FVector::ZeroVector, DeltaSeconds, 15.0f);
-	FootIKValues.FootOffset_R_Location = FMath::VInterpTo(FootIKValues.FootOffset_R_Location,
-	                                                      FVector::ZeroVector, DeltaSeconds, 15.0f);
-	FootIKValues.FootOffset_L_Rotation = FMath::RInterpTo(FootIKValues.FootOffset_L_Rotation,
-	                                                      FRotator::ZeroRotator, DeltaSeconds, 15.0f);
-	FootIKValues.FootOffset_R_Rotation = FMath::RInterpTo(FootIKValues.FootOffset_R_Rotation,
-	                                                      FRotator::ZeroRotator, DeltaSeconds, 15.0f);
+	FootIKValues.FootOffset_L_Location = UALSMathLibrary::VInterpToSubstepped(
+		FootIKValues.FootOffset_L_Location, FVector::ZeroVector, DeltaSeconds, 15.0f, Config->MaxInterpSubstep);
+	FootIKValues.FootOffset_R_Location = UALSMathLibrary::VInterpToSubstepped(
+		FootIKValues.FootOffset_R_Location, FVector::ZeroVector, DeltaSeconds, 15.0f, Config->MaxInterpSubstep);
+	FootIKValues.FootOffset_L_Rotation = UALSMathLibrary::RInterpToSubstepped(
+		FootIKValues.FootOffset_L_Rotation, FRotator::ZeroRotator, DeltaSeconds, 15.0f, Config->MaxInterpSubstep);
+	FootIKValues.FootOffset_R_Rotation = UALSMathLibrary::RInterpToSubstepped(
+		FootIKValues.FootOffset_R_Rotation, FRotator::ZeroRotator, DeltaSeconds, 15.0f, Config->MaxInterpSubstep);
 }
 
-void UALSCharacterAnimInstance::SetFootOffsets(float DeltaSeconds, FName EnableFootIKCurve, FName IKFootBone,
-                                               FName RootBone, FVector& CurLocationTarget, FVector& CurLocationOffset,
-                                               FRotator& CurRotationOffset)
+void UALSCharacterAnimInstance::SetFootOffsets(float DeltaSeconds, EALSAnimCurve EnableFootIKCurve,
+                                               const FVector& LocationTarget, const FRotator& RotationTarget,
+                                               FVector& CurLocationOffset, FRotator& CurRotationOffset)
 {
 	// Only update Foot IK offset values if the Foot IK curve has a weight. If it equals 0, clear the offset values.
-	if (GetCurveValue(EnableFootIKCurve) <= 0)
+	if (CurveCache.Get(EnableFootIKCurve) <= 0)
 	{
 		CurLocationOffset = FVector::ZeroVector;
 		CurRotationOffset = FRotator::ZeroRotator;
 		return;
 	}
 
+	// Step 1: Interp the Current Location Offset to the new target value.
+	// Interpolate at different speeds based on whether the new target is above or below the current one.
+	const float InterpSpeed = CurLocationOffset.Z > LocationTarget.Z ? 30.f : 15.0f;
+	CurLocationOffset = UALSMathLibrary::VInterpToSubstepped(CurLocationOffset, LocationTarget, DeltaSeconds,
+	                                                         InterpSpeed, Config->MaxInterpSubstep);
+
+	// Step 2: Interp the Current Rotation Offset to the new target value.
+	CurRotationOffset = UALSMathLibrary::RInterpToSubstepped(CurRotationOffset, RotationTarget, DeltaSeconds, 30.0f,
+	                                                         Config->MaxInterpSubstep);
+}
+
+void UALSCharacterAnimInstance::TraceFootOffsets(EALSAnimCurve EnableFootIKCurve, EALSBone IKFootBone,
+                                                 FTraceHandle& TraceHandle, FALSFootIKTraceCache& TraceCache,
+                                                 FVector& OutLocationTarget, FRotator& OutRotationTarget)
+{
+	// Offsets are cleared in the thread safe update if the Foot IK curve has no weight, no need to trace.
+	if (CurveCache.Get(EnableFootIKCurve) <= 0)
+	{
+		TraceHandle.Invalidate();
+		TraceCache.bValid = false;
+		return;
+	}
+
 	// Step 1: Trace downward from the foot location to find the geometry.
 	// If the surface is walkable, save the Impact Location and Normal.
 	USkeletalMeshComponent* OwnerComp = GetOwningComponent();
-	FVector IKFootFloorLoc = OwnerComp->GetSocketLocation(IKFootBone);
-	IKFootFloorLoc.Z = OwnerComp->GetSocketLocation(RootBone).Z;
+	FVector IKFootFloorLoc = BoneCache.GetLocation(*OwnerComp, IKFootBone);
+	IKFootFloorLoc.Z = BoneCache.GetLocation(*OwnerComp, EALSBone::Root).Z;
 
-	UWorld* World = GetWorld();
-	check(World);
+	FVector ImpactPoint;
+	FVector ImpactNormal;
+	bool bWalkable;
 
-	FCollisionQueryParams Params;
-	Params.AddIgnoredActor(Character);
+	if (Config->bUseFootIKTraceCache && !bForceSyncFootIKTraces &&
+		TraceCache.CanReuse(IKFootFloorLoc, Config->FootIKTraceCacheEpsilon))
+	{
+		// Step 1.1: Foot and ground didn't move, reuse the last trace result.
+		ImpactPoint = TraceCache.ImpactPoint;
+		ImpactNormal = TraceCache.ImpactNormal;
+		bWalkable = TraceCache.bWalkable;
+		// A pending async trace would be outdated when the cache gets invalidated
+		TraceHandle.Invalidate();
+		ALSFootIKTraceCacheStats::Record(true);
+	}
+	else
+	{
+		UWorld* World = GetWorld();
+		check(World);
 
-	FHitResult HitResult;
-	World->LineTraceSingleByChannel(HitResult,
-	                                IKFootFloorLoc + FVector(0.0, 0.0, Config.IK_TraceDistanceAboveFoot),
-	                                IKFootFloorLoc - FVector(0.0, 0.0, Config.IK_TraceDistanceBelowFoot),
-	                                ECC_Visibility, Params);
+		FCollisionQueryParams Params;
+		Params.AddIgnoredActor(Character);
 
-	FRotator TargetRotOffset = FRotator::ZeroRotator;
-	if (Character->GetCharacterMovement()->IsWalkable(HitResult))
-	{
-		FVector ImpactPoint = HitResult.ImpactPoint;
-		FVector ImpactNormal = HitResult.ImpactNormal;
+		const FVector TraceStart = IKFootFloorLoc + FVector(0.0, 0.0, Config->IK_TraceDistanceAboveFoot);
+		const FVector TraceEnd = IKFootFloorLoc - FVector(0.0, 0.0, Config->IK_TraceDistanceBelowFoot);
 
-		// Step 1.1: Find the difference in location from the Impact point and the expected (flat) floor location.
-		// These values are offset by the nomrmal multiplied by the
-		// foot height to get better behavior on angled surfaces.
-		CurLocationTarget = (ImpactPoint + ImpactNormal * Config.FootHeight) -
-			(IKFootFloorLoc + FVector(0, 0, Config.FootHeight));
+		FHitResult HitResult;
+		bool bHasHitResult = false;
+		if (Config->bUseAsyncFootIKTraces && !bForceSyncFootIKTraces)
+		{
+			// Use the result of the trace requested on previous frame, and request a new one for the next frame.
+			FTraceDatum TraceDatum;
+			if (TraceHandle.IsValid() && World->QueryTraceData(TraceHandle, TraceDatum))
+			{
+				if (TraceDatum.OutHits.Num() > 0)
+				{
+					HitResult = TraceDatum.OutHits[0];
+				}
+				bHasHitResult = true;
+			}
+			TraceHandle = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, TraceStart, TraceEnd,
+			                                             ECC_Visibility, Params);
+		}
+		else
+		{
+			TraceHandle.Invalidate();
+		}
+
+		if (!bHasHitResult)
+		{
+			World->LineTraceSingleByChannel(HitResult, TraceStart, TraceEnd, ECC_Visibility, Params);
+		}
+
+		ImpactPoint = HitResult.ImpactPoint;
+		ImpactNormal = HitResult.ImpactNormal;
+		bWalkable = Character->GetCharacterMovement()->IsWalkable(HitResult);
 
-		// Step 1.2: Calculate the Rotation offset by getting the Atan2 of the Impact Normal.
-		TargetRotOffset.Pitch = -FMath::RadiansToDegrees(FMath::Atan2(ImpactNormal.X, ImpactNormal.Z));
-		TargetRotOffset.Roll = FMath::RadiansToDegrees(FMath::Atan2(ImpactNormal.Y, ImpactNormal.Z));
+		if (Config->bUseFootIKTraceCache)
+		{
+			TraceCache.Store(IKFootFloorLoc, HitResult, bWalkable);
+			ALSFootIKTraceCacheStats::Record(false);
+		}
 	}
 
-	// Step 2: Interp the Current Location Offset to the new target value.
-	// Interpolate at different speeds based on whether the new target is above or below the current one.
-	const float InterpSpeed = CurLocationOffset.Z > CurLocationTarget.Z ? 30.f : 15.0f;
-	CurLocationOffset = FMath::VInterpTo(CurLocationOffset, CurLocationTarget, DeltaSeconds, InterpSpeed);
+	if (bWalkable)
+	{
+		// Step 2: Find the difference in location from the Impact point and the expected (flat) floor location.
+		// These values are offset by the nomrmal multiplied by the
+		// foot height to get better behavior on angled surfaces.
+		OutLocationTarget = (ImpactPoint + ImpactNormal * Config->FootHeight) -
+			(IKFootFloorLoc + FVector(0, 0, Config->FootHeight));
 
-	// Step 3: Interp the Current Rotation Offset to the new target value.
-	CurRotationOffset = FMath::RInterpTo(CurRotationOffset, TargetRotOffset, DeltaSeconds, 30.0f);
+		// Step 3: Calculate the Rotation offset by getting the Atan2 of the Impact Normal.
+		OutRotationTarget.Pitch = -FMath::RadiansToDegrees(FMath::Atan2(ImpactNormal.X, ImpactNormal.Z));
+		OutRotationTarget.Roll = FMath::RadiansToDegrees(FMath::Atan2(ImpactNormal.Y, ImpactNormal.Z));
+	}
 }
 
 void UALSCharacterAnimInstance::RotateInPlaceCheck()
 {
 	// Step 1: Check if the character should rotate left or right by checking if the Aiming Angle exceeds the threshold.
-	Grounded.bRotateL = AimingValues.AimingAngle.X < RotateInPlace.RotateMinThreshold;
-	Grounded.bRotateR = AimingValues.AimingAngle.X > RotateInPlace.RotateMaxThreshold;
+	Grounded.bRotateL = AimingValues.AimingAngle.X < RotateInPlace->RotateMinThreshold;
+	Grounded.bRotateR = AimingValues.AimingAngle.X > RotateInPlace->RotateMaxThreshold;
 
 	// Step 2: If the character should be rotating, set the Rotate Rate to scale with the Aim Yaw Rate.
 	// This makes the character rotate faster when moving the camera faster.
 	if (Grounded.bRotateL || Grounded.bRotateR)
 	{
 		Grounded.RotateRate = FMath::GetMappedRangeValueClamped(
-			{RotateInPlace.AimYawRateMinRange, RotateInPlace.AimYawRateMaxRange},
-			{RotateInPlace.MinPlayRate, RotateInPlace.MaxPlayRate},
+			{RotateInPlace->AimYawRateMinRange, RotateInPlace->AimYawRateMaxRange},
+			{RotateInPlace->MinPlayRate, RotateInPlace->MaxPlayRate},
 			CharacterInformation.AimYawRate);
 	}
 }
@@ -478,23 +1298,23 @@ void UALSCharacterAnimInstance::TurnInPlaceCheck(float DeltaSeconds)
 	// Step 1: Check if Aiming angle is outside of the Turn Check Min Angle, and if the Aim Yaw Rate is below the Aim Yaw Rate Limit.
 	// If so, begin counting the Elapsed Delay Time. If not, reset the Elapsed Delay Time.
 	// This ensures the conditions remain true for a sustained peroid of time before turning in place.
-	if (FMath::Abs(AimingValues.AimingAngle.X) <= TurnInPlaceValues.TurnCheckMinAngle ||
-		CharacterInformation.AimYawRate >= TurnInPlaceValues.AimYawRateLimit)
+	if (FMath::Abs(AimingValues.AimingAngle.X) <= TurnInPlace->TurnCheckMinAngle ||
+		CharacterInformation.AimYawRate >= TurnInPlace->AimYawRateLimit)
 	{
-		TurnInPlaceValues.ElapsedDelayTime = 0.0f;
+		TurnInPlaceDelayTime = 0.0f;
 		return;
 	}
 
-	TurnInPlaceValues.ElapsedDelayTime += DeltaSeconds;
-	const float ClampedAimAngle = FMath::GetMappedRangeValueClamped({TurnInPlaceValues.TurnCheckMinAngle, 180.0f},
+	TurnInPlaceDelayTime += DeltaSeconds;
+	const float ClampedAimAngle = FMath::GetMappedRangeValueClamped({TurnInPlace->TurnCheckMinAngle, 180.0f},
 	                                                                {
-		                                                                TurnInPlaceValues.MinAngleDelay,
-		                                                                TurnInPlaceValues.MaxAngleDelay
+		                                                                TurnInPlace->MinAngleDelay,
+		                                                                TurnInPlace->MaxAngleDelay
 	                                                                },
 	                                                                AimingValues.AimingAngle.X);
 
 	// Step 2: Check if the Elapsed Delay time exceeds the set delay (mapped to the turn angle range). If so, trigger a Turn In Place.
-	if (TurnInPlaceValues.ElapsedDelayTime > ClampedAimAngle)
+	if (TurnInPlaceDelayTime > ClampedAimAngle)
 	{
 		FRotator TurnInPlaceYawRot = CharacterInformation.AimingRotation;
 		TurnInPlaceYawRot.Roll = 0.0f;
@@ -509,14 +1329,14 @@ void UALSCharacterAnimInstance::DynamicTransitionCheck()
 	// (determined via a virtual bone) exceeds a threshold. If it does, play an additive transition animation on that foot.
 	// The currently set transition plays the second half of a 2 foot transition animation, so that only a single foot moves.
 	// Because only the IK_Foot bone can be locked, the separate virtual bone allows the system to know its desired location when locked.
-	FTransform SocketTransformA = GetOwningComponent()->GetSocketTransform(FName(TEXT("ik_foot_l")), RTS_Component);
-	FTransform SocketTransformB = GetOwningComponent()->GetSocketTransform(
-		FName(TEXT("VB foot_target_l")), RTS_Component);
-	float Distance = (SocketTransformB.GetLocation() - SocketTransformA.GetLocation()).Size();
-	if (Distance > Config.DynamicTransitionThreshold)
+	const USkeletalMeshComponent* OwnerComp = GetOwningComponent();
+	FVector SocketLocationA = BoneCache.GetLocation(*OwnerComp, EALSBone::IKFoot_L, RTS_Component);
+	FVector SocketLocationB = BoneCache.GetLocation(*OwnerComp, EALSBone::FootTarget_L, RTS_Component);
+	float Distance = (SocketLocationB - SocketLocationA).Size();
+	if (Distance > Config->DynamicTransitionThreshold)
 	{
 		FALSDynamicMontageParams Params;
-		Params.Animation = TransitionAnim_R;
+		Params.Animation = ActiveAnimConfig->TransitionAnim_R;
 		Params.BlendInTime = 0.2f;
 		Params.BlendOutTime = 0.2f;
 		Params.PlayRate = 1.5f;
@@ -524,13 +1344,13 @@ void UALSCharacterAnimInstance::DynamicTransitionCheck()
 		PlayDynamicTransition(0.1f, Params);
 	}
 
-	SocketTransformA = GetOwningComponent()->GetSocketTransform(FName(TEXT("ik_foot_r")), RTS_Component);
-	SocketTransformB = GetOwningComponent()->GetSocketTransform(FName(TEXT("VB foot_target_r")), RTS_Component);
-	Distance = (SocketTransformB.GetLocation() - SocketTransformA.GetLocation()).Size();
-	if (Distance > Config.DynamicTransitionThreshold)
+	SocketLocationA = BoneCache.GetLocation(*OwnerComp, EALSBone::IKFoot_R, RTS_Component);
+	SocketLocationB = BoneCache.GetLocation(*OwnerComp, EALSBone::FootTarget_R, RTS_Component);
+	Distance = (SocketLocationB - SocketLocationA).Size();
+	if (Distance > Config->DynamicTransitionThreshold)
 	{
 		FALSDynamicMontageParams Params;
-		Params.Animation = TransitionAnim_L;
+		Params.Animation = ActiveAnimConfig->TransitionAnim_L;
 		Params.BlendInTime = 0.2f;
 		Params.BlendOutTime = 0.2f;
 		Params.PlayRate = 1.5f;
@@ -541,22 +1361,51 @@ void UALSCharacterAnimInstance::DynamicTransitionCheck()
 
 void UALSCharacterAnimInstance::UpdateMovementValues(float DeltaSeconds)
 {
-	// Interp and set the Velocity Blend.
-	const FALSVelocityBlend& TargetBlend = CalculateVelocityBlend();
-	VelocityBlend.F = FMath::FInterpTo(VelocityBlend.F, TargetBlend.F, DeltaSeconds, Config.VelocityBlendInterpSpeed);
-	VelocityBlend.B = FMath::FInterpTo(VelocityBlend.B, TargetBlend.B, DeltaSeconds, Config.VelocityBlendInterpSpeed);
-	VelocityBlend.L = FMath::FInterpTo(VelocityBlend.L, TargetBlend.L, DeltaSeconds, Config.VelocityBlendInterpSpeed);
-	VelocityBlend.R = FMath::FInterpTo(VelocityBlend.R, TargetBlend.R, DeltaSeconds, Config.VelocityBlendInterpSpeed);
+	// Interp and set the Velocity Blend. The target only changes with the velocity and the actor rotation.
+	const FVector& Velocity = CharacterInformation.Velocity;
+	if (ALSDirtyTracking::ShouldRecompute(*Config, VelocityBlendInputs,
+	                                      {Velocity.X, Velocity.Y, Velocity.Z,
+	                                       CharacterInformation.CharacterActorRotation.Yaw}))
+	{
+		TargetVelocityBlend = CalculateVelocityBlend();
+	}
+	VelocityBlend.F = UALSMathLibrary::FInterpToSubstepped(VelocityBlend.F, TargetVelocityBlend.F, DeltaSeconds,
+	                                                       Config->VelocityBlendInterpSpeed, Config->MaxInterpSubstep);
+	VelocityBlend.B = UALSMathLibrary::FInterpToSubstepped(VelocityBlend.B, TargetVelocityBlend.B, DeltaSeconds,
+	                                                       Config->VelocityBlendInterpSpeed, Config->MaxInterpSubstep);
+	VelocityBlend.L = UALSMathLibrary::FInterpToSubstepped(VelocityBlend.L, TargetVelocityBlend.L, DeltaSeconds,
+	                                                       Config->VelocityBlendInterpSpeed, Config->MaxInterpSubstep);
+	VelocityBlend.R = UALSMathLibrary::FInterpToSubstepped(VelocityBlend.R, TargetVelocityBlend.R, DeltaSeconds,
+	                                                       Config->VelocityBlendInterpSpeed, Config->MaxInterpSubstep);
+
+	// Diagonal scale and lean only shape the pose, the server anim mode skips them
+	if (!bServerAnimMode)
+	{
+		// Set the Diagonal Scale Amount.
+		if (ALSDirtyTracking::ShouldRecompute(*Config, DiagonalScaleInputs, {VelocityBlend.F + VelocityBlend.B}))
+		{
+			Grounded.DiagonalScaleAmount = CalculateDiagonalScaleAmount();
+		}
 
-	// Set the Diagonal Scale Amount.
-	Grounded.DiagonalScaleAmount = CalculateDiagonalScaleAmount();
+		// Set the Relative Acceleration Amount and Interp the Lean Amount.
+		RelativeAccelerationAmount = CalculateRelativeAccelerationAmount();
+		LeanAmount.LR = UALSMathLibrary::FInterpToSubstepped(LeanAmount.LR, RelativeAccelerationAmount.Y,
+		                                                     DeltaSeconds, Config->GroundedLeanInterpSpeed,
+		                                                     Config->MaxInterpSubstep);
+		LeanAmount.FB = UALSMathLibrary::FInterpToSubstepped(LeanAmount.FB, RelativeAccelerationAmount.X,
+		                                                     DeltaSeconds, Config->GroundedLeanInterpSpeed,
+		                                                     Config->MaxInterpSubstep);
+	}
 
-	// Set the Relative Acceleration Amount and Interp the Lean Amount.
-	RelativeAccelerationAmount = CalculateRelativeAccelerationAmount();
-	LeanAmount.LR = FMath::FInterpTo(LeanAmount.LR, RelativeAccelerationAmount.Y, DeltaSeconds,
-	                                 Config.GroundedLeanInterpSpeed);
-	LeanAmount.FB = FMath::FInterpTo(LeanAmount.FB, RelativeAccelerationAmount.X, DeltaSeconds,
-	                                 Config.GroundedLeanInterpSpeed);
+	// Walk run blend, stride blend and play rates only change with the speed, the gait and the gait curves
+	if (!ALSDirtyTracking::ShouldRecompute(*Config, StrideInputs,
+	                                       {CharacterInformation.Speed, GameThreadValues.MeshScaleZ,
+	                                        static_cast<float>(static_cast<EALSGait>(Gait)),
+	                                        CurveCache.Get(EALSAnimCurve::W_Gait),
+	                                        CurveCache.Get(EALSAnimCurve::BasePose_CLF)}))
+	{
+		return;
+	}
 
 	// Set the Walk Run Blend
 	Grounded.WalkRunBlend = CalculateWalkRunBlend();
@@ -579,10 +1428,15 @@ void UALSCharacterAnimInstance::UpdateRotationValues()
 	// behaves for each movement direction.
 	FRotator Delta = CharacterInformation.Velocity.ToOrientationRotator() - CharacterInformation.AimingRotation;
 	Delta.Normalize();
-	const FVector& FBOffset = YawOffset_FB->GetVectorValue(Delta.Yaw);
+	if (!ALSDirtyTracking::ShouldRecompute(*Config, YawOffsetInputs, {Delta.Yaw}))
+	{
+		return;
+	}
+
+	const FVector& FBOffset = YawOffset_FBLUT.GetValue(Delta.Yaw);
 	Grounded.FYaw = FBOffset.X;
 	Grounded.BYaw = FBOffset.Y;
-	const FVector& LROffset = YawOffset_LR->GetVectorValue(Delta.Yaw);
+	const FVector& LROffset = YawOffset_LRLUT.GetValue(Delta.Yaw);
 	Grounded.LYaw = LROffset.X;
 	Grounded.RYaw = LROffset.Y;
 }
@@ -598,25 +1452,25 @@ void UALSCharacterAnimInstance::UpdateInAirValues(float DeltaSeconds)
 
 	// Interp and set the In Air Lean Amount
 	const FALSLeanAmount& InAirLeanAmount = CalculateAirLeanAmount();
-	LeanAmount.LR = FMath::FInterpTo(LeanAmount.LR, InAirLeanAmount.LR, DeltaSeconds, Config.GroundedLeanInterpSpeed);
-	LeanAmount.FB = FMath::FInterpTo(LeanAmount.FB, InAirLeanAmount.FB, DeltaSeconds, Config.GroundedLeanInterpSpeed);
+	LeanAmount.LR = UALSMathLibrary::FInterpToSubstepped(LeanAmount.LR, InAirLeanAmount.LR, DeltaSeconds,
+	                                                     Config->GroundedLeanInterpSpeed, Config->MaxInterpSubstep);
+	LeanAmount.FB = UALSMathLibrary::FInterpToSubstepped(LeanAmount.FB, InAirLeanAmount.FB, DeltaSeconds,
+	                                                     Config->GroundedLeanInterpSpeed, Config->MaxInterpSubstep);
 }
 
 void UALSCharacterAnimInstance::UpdateRagdollValues()
 {
 	// Scale the Flail Rate by the velocity length. The faster the ragdoll moves, the faster the character will flail.
-	const float VelocityLength = GetOwningComponent()->GetPhysicsLinearVelocity(FName(TEXT("root"))).Size();
-	FlailRate = FMath::GetMappedRangeValueClamped({0.0f, 1000.0f}, {0.0f, 1.0f}, VelocityLength);
-}
-
-float UALSCharacterAnimInstance::GetAnimCurveClamped(const FName& Name, float Bias, float ClampMin,
-                                                     float ClampMax) const
-{
-	return FMath::Clamp(GetCurveValue(Name) + Bias, ClampMin, ClampMax);
+	FlailRate = FMath::GetMappedRangeValueClamped({0.0f, 1000.0f}, {0.0f, 1.0f}, GameThreadValues.RagdollVelocity);
 }
 
 FALSVelocityBlend UALSCharacterAnimInstance::CalculateVelocityBlend() const
 {
+	if (GameThreadValues.bHasKernelOutput)
+	{
+		return KernelOutput.VelocityBlend;
+	}
+
 	// Calculate the Velocity Blend. This value represents the velocity amount of the actor in each direction (normalized so that
 	// diagonals equal .5 for each direction), and is used in a BlendMulti node to produce better
 	// directional blending than a standard blendspace.
@@ -635,17 +1489,22 @@ FALSVelocityBlend UALSCharacterAnimInstance::CalculateVelocityBlend() const
 
 FVector UALSCharacterAnimInstance::CalculateRelativeAccelerationAmount() const
 {
+	if (GameThreadValues.bHasKernelOutput)
+	{
+		return KernelOutput.RelativeAcceleration;
+	}
+
 	// Calculate the Relative Acceleration Amount. This value represents the current amount of acceleration / deceleration
 	// relative to the actor rotation. It is normalized to a range of -1 to 1 so that -1 equals the Max Braking Deceleration,
 	// and 1 equals the Max Acceleration of the Character Movement Component.
 	if (FVector::DotProduct(CharacterInformation.Acceleration, CharacterInformation.Velocity) > 0.0f)
 	{
-		const float MaxAcc = Character->GetCharacterMovement()->GetMaxAcceleration();
+		const float MaxAcc = GameThreadValues.MaxAcceleration;
 		return CharacterInformation.CharacterActorRotation.UnrotateVector(
 			CharacterInformation.Acceleration.GetClampedToMaxSize(MaxAcc) / MaxAcc);
 	}
 
-	const float MaxBrakingDec = Character->GetCharacterMovement()->GetMaxBrakingDeceleration();
+	const float MaxBrakingDec = GameThreadValues.MaxBrakingDeceleration;
 	return
 		CharacterInformation.CharacterActorRotation.UnrotateVector(
 			CharacterInformation.Acceleration.GetClampedToMaxSize(MaxBrakingDec) / MaxBrakingDec);
@@ -658,13 +1517,13 @@ float UALSCharacterAnimInstance::CalculateStrideBlend() const
 	// It also allows the walk or run gait animations to blend independently while still matching the animation speed to
 	// the movement speed, preventing the character from needing to play a half walk+half run blend.
 	// The curves are used to map the stride amount to the speed for maximum control.
-	const float CurveTime = CharacterInformation.Speed / GetOwningComponent()->GetComponentScale().Z;
-	const float ClampedGait = GetAnimCurveClamped(FName(TEXT("W_Gait")), -1.0, 0.0f, 1.0f);
+	const float CurveTime = CharacterInformation.Speed / GameThreadValues.MeshScaleZ;
+	const float ClampedGait = CurveCache.GetClamped(EALSAnimCurve::W_Gait, -1.0, 0.0f, 1.0f);
 	const float LerpedStrideBlend =
-		FMath::Lerp(StrideBlend_N_Walk->GetFloatValue(CurveTime), StrideBlend_N_Run->GetFloatValue(CurveTime),
+		FMath::Lerp(StrideBlend_N_WalkLUT.GetValue(CurveTime), StrideBlend_N_RunLUT.GetValue(CurveTime),
 		            ClampedGait);
-	return FMath::Lerp(LerpedStrideBlend, StrideBlend_C_Walk->GetFloatValue(CharacterInformation.Speed),
-	                   GetCurveValue(FName(TEXT("BasePose_CLF"))));
+	return FMath::Lerp(LerpedStrideBlend, StrideBlend_C_WalkLUT.GetValue(CharacterInformation.Speed),
+	                   CurveCache.Get(EALSAnimCurve::BasePose_CLF));
 }
 
 float UALSCharacterAnimInstance::CalculateWalkRunBlend() const
@@ -679,15 +1538,19 @@ float UALSCharacterAnimInstance::CalculateStandingPlayRate() const
 	// The lerps are determined by the "W_Gait" anim curve that exists on every locomotion cycle so
 	// that the play rate is always in sync with the currently blended animation.
 	// The value is also divided by the Stride Blend and the mesh scale so that the play rate increases as the stride or scale gets smaller
-	const float LerpedSpeed = FMath::Lerp(CharacterInformation.Speed / Config.AnimatedWalkSpeed,
-	                                      CharacterInformation.Speed / Config.AnimatedRunSpeed,
-	                                      GetAnimCurveClamped(FName(TEXT("W_Gait")), -1.0f, 0.0f, 1.0f));
+	if (GameThreadValues.bHasKernelOutput)
+	{
+		return FMath::Clamp(KernelOutput.StandingSpeedRate / Grounded.StrideBlend, 0.0f, 3.0f);
+	}
+
+	const float LerpedSpeed = FMath::Lerp(CharacterInformation.Speed / Config->AnimatedWalkSpeed,
+	                                      CharacterInformation.Speed / Config->AnimatedRunSpeed,
+	                                      CurveCache.GetClamped(EALSAnimCurve::W_Gait, -1.0f, 0.0f, 1.0f));
 
-	const float SprintAffectedSpeed = FMath::Lerp(LerpedSpeed, CharacterInformation.Speed / Config.AnimatedSprintSpeed,
-	                                              GetAnimCurveClamped(FName(TEXT("W_Gait")), -2.0f, 0.0f, 1.0f));
+	const float SprintAffectedSpeed = FMath::Lerp(LerpedSpeed, CharacterInformation.Speed / Config->AnimatedSprintSpeed,
+	                                              CurveCache.GetClamped(EALSAnimCurve::W_Gait, -2.0f, 0.0f, 1.0f));
 
-	return FMath::Clamp((SprintAffectedSpeed / Grounded.StrideBlend) / GetOwningComponent()->GetComponentScale().Z,
-	                    0.0f, 3.0f);
+	return FMath::Clamp((SprintAffectedSpeed / Grounded.StrideBlend) / GameThreadValues.MeshScaleZ, 0.0f, 3.0f);
 }
 
 float UALSCharacterAnimInstance::CalculateDiagonalScaleAmount() const
@@ -695,32 +1558,48 @@ float UALSCharacterAnimInstance::CalculateDiagonalScaleAmount() const
 	// Calculate the Diagnal Scale Amount. This value is used to scale the Foot IK Root bone to make the Foot IK bones
 	// cover more distance on the diagonal blends. Without scaling, the feet would not move far enough on the diagonal
 	// direction due to the linear translational blending of the IK bones. The curve is used to easily map the value.
-	return DiagonalScaleAmountCurve->GetFloatValue(FMath::Abs(VelocityBlend.F + VelocityBlend.B));
+	return DiagonalScaleAmountLUT.GetValue(FMath::Abs(VelocityBlend.F + VelocityBlend.B));
 }
 
 float UALSCharacterAnimInstance::CalculateCrouchingPlayRate() const
 {
 	// Calculate the Crouching Play Rate by dividing the Character's speed by the Animated Speed.
 	// This value needs to be separate from the standing play rate to improve the blend from crocuh to stand while in motion.
+	if (GameThreadValues.bHasKernelOutput)
+	{
+		return FMath::Clamp(KernelOutput.CrouchingSpeedRate / Grounded.StrideBlend, 0.0f, 2.0f);
+	}
+
 	return FMath::Clamp(
-		CharacterInformation.Speed / Config.AnimatedCrouchSpeed / Grounded.StrideBlend / GetOwningComponent()->
-		GetComponentScale().Z,
+		CharacterInformation.Speed / Config->AnimatedCrouchSpeed / Grounded.StrideBlend / GameThreadValues.MeshScaleZ,
 		0.0f, 2.0f);
 }
 
 float UALSCharacterAnimInstance::CalculateLandPrediction() const
 {
-	// Calculate the land prediction weight by tracing in the velocity direction to find a walkable surface the character
-	// is falling toward, and getting the 'Time' (range of 0-1, 1 being maximum, 0 being about to land) till impact.
+	// Calculate the land prediction weight by using the 'Time' (range of 0-1, 1 being maximum, 0 being about to land)
+	// till impact, found by the land prediction sweep on game thread.
 	// The Land Prediction Curve is used to control how the time affects the final weight for a smooth blend. 
-	if (InAir.FallSpeed >= -200.0f)
+	if (InAir.FallSpeed >= -200.0f || GameThreadValues.LandPredictionTime < 0.0f)
 	{
 		return 0.0f;
 	}
 
+	return FMath::Lerp(LandPredictionLUT.GetValue(GameThreadValues.LandPredictionTime), 0.0f,
+	                   CurveCache.Get(EALSAnimCurve::Mask_LandPrediction)) * GameThreadValues.LandPredictionWeight;
+}
+
+void UALSCharacterAnimInstance::TraceLandPrediction()
+{
+	// Trace in the velocity direction to find a walkable surface the character is falling toward.
+	const float VelocityZ = CharacterInformation.Velocity.Z;
+	if (VelocityZ >= -200.0f)
+	{
+		return;
+	}
+
 	const UCapsuleComponent* CapsuleComp = Character->GetCapsuleComponent();
 	const FVector& CapsuleWorldLoc = CapsuleComp->GetComponentLocation();
-	const float VelocityZ = CharacterInformation.Velocity.Z;
 	FVector VelocityClamped = CharacterInformation.Velocity;
 	VelocityClamped.Z = FMath::Clamp(VelocityZ, -4000.0f, -200.0f);
 	VelocityClamped.Normalize();
@@ -743,11 +1622,113 @@ float UALSCharacterAnimInstance::CalculateLandPrediction() const
 
 	if (Character->GetCharacterMovement()->IsWalkable(HitResult))
 	{
-		return FMath::Lerp(LandPredictionCurve->GetFloatValue(HitResult.Time), 0.0f,
-		                   GetCurveValue(FName(TEXT("Mask_LandPrediction"))));
+		GameThreadValues.LandPredictionTime = HitResult.Time;
 	}
+}
+
+void UALSCharacterAnimInstance::UpdateAnalyticLandPrediction()
+{
+	UWorld* World = GetWorld();
+	check(World);
+
+	const UCharacterMovementComponent* CharacterMovement = Character->GetCharacterMovement();
+	const float Time = World->GetTimeSeconds();
+	const float GravityZ = CharacterMovement->GetGravityZ();
+	FALSLandPredictionCache& Cache = LandPredictionCache;
+
+	// Results of the segment sweeps requested on a previous update, they're all in the same async trace batch
+	if (LandPredictionTraceHandles.Num() > 0)
+	{
+		bool bReady = true;
+		float ImpactTime = -1.0f;
+		for (int32 Segment = 0; Segment < LandPredictionTraceHandles.Num(); ++Segment)
+		{
+			FTraceDatum TraceDatum;
+			if (!World->QueryTraceData(LandPredictionTraceHandles[Segment], TraceDatum))
+			{
+				bReady = false;
+				break;
+			}
+
+			// The first blocking hit ends the trajectory, the hit time is the fraction of the segment swept
+			const FHitResult* Hit = FHitResult::GetFirstBlockingHit(TraceDatum.OutHits);
+			if (Hit)
+			{
+				if (CharacterMovement->IsWalkable(*Hit))
+				{
+					const float SegmentStartTime = Cache.SegmentTimes[Segment];
+					ImpactTime = SegmentStartTime + Hit->Time * (Cache.SegmentTimes[Segment + 1] - SegmentStartTime);
+				}
+				break;
+			}
+		}
 
-	return 0.0f;
+		if (bReady)
+		{
+			LandPredictionTraceHandles.Reset();
+			Cache.bValid = true;
+			Cache.ImpactTime = ImpactTime;
+		}
+		else if (!World->IsTraceHandleValid(LandPredictionTraceHandles[0], false))
+		{
+			// Results are dropped if they aren't read on the next frame, sweep again
+			LandPredictionTraceHandles.Reset();
+		}
+	}
+
+	// Same reach as the sweep of TraceLandPrediction at the highest fall speed
+	constexpr float MaxFallDistance = 2000.0f;
+	const float Elapsed = Time - Cache.StartTime;
+	const FVector& Velocity = CharacterInformation.Velocity;
+	const bool bLeftTrajectory = !Cache.GetVelocity(Time, GravityZ).Equals(Velocity,
+	                                                                       Config->LandPredictionRefreshVelocity);
+	const bool bExpired = Cache.ImpactTime >= 0.0f
+		                      ? Elapsed > Cache.ImpactTime
+		                      : Cache.StartLocation.Z - Character->GetActorLocation().Z > MaxFallDistance;
+	if ((!Cache.bValid || bLeftTrajectory || bExpired) && LandPredictionTraceHandles.Num() == 0)
+	{
+		Cache.bValid = false;
+		Cache.StartTime = Time;
+		Cache.StartLocation = Character->GetCapsuleComponent()->GetComponentLocation();
+		Cache.StartVelocity = Velocity;
+		Cache.ImpactTime = -1.0f;
+
+		// Sweep the segments of the trajectory down to the farthest surface the prediction cares about
+		const float EndTime = Cache.GetTimeAtHeight(Cache.StartLocation.Z - MaxFallDistance, GravityZ);
+		if (EndTime > 0.0f)
+		{
+			Cache.SetSegments(EndTime, GravityZ);
+			const UCapsuleComponent* CapsuleComp = Character->GetCapsuleComponent();
+			const FCollisionShape CapsuleShape = FCollisionShape::MakeCapsule(
+				CapsuleComp->GetUnscaledCapsuleRadius(), CapsuleComp->GetUnscaledCapsuleHalfHeight());
+			FCollisionQueryParams Params;
+			Params.AddIgnoredActor(Character);
+			for (int32 Segment = 0; Segment + 1 < Cache.SegmentTimes.Num(); ++Segment)
+			{
+				LandPredictionTraceHandles.Add(World->AsyncSweepByChannel(
+					EAsyncTraceType::Single, Cache.GetLocation(Time + Cache.SegmentTimes[Segment], GravityZ),
+					Cache.GetLocation(Time + Cache.SegmentTimes[Segment + 1], GravityZ), FQuat::Identity,
+					ECC_Visibility, CapsuleShape, Params));
+			}
+		}
+	}
+
+	// Convert the time left to the impact to the hit time of the sweep TraceLandPrediction would do
+	GameThreadValues.LandPredictionTime = -1.0f;
+	const float VelocityZ = Velocity.Z;
+	if (!Cache.bValid || Cache.ImpactTime < 0.0f || VelocityZ >= -200.0f)
+	{
+		return;
+	}
+
+	const float TraceLength = FMath::GetMappedRangeValueClamped({0.0f, -4000.0f}, {50.0f, 2000.0f}, VelocityZ);
+	const float DistanceToImpact = FVector::Dist(
+		Cache.GetLocation(Cache.StartTime + FMath::Min(Elapsed, Cache.ImpactTime), GravityZ),
+		Cache.GetLocation(Cache.StartTime + Cache.ImpactTime, GravityZ));
+	if (DistanceToImpact <= TraceLength)
+	{
+		GameThreadValues.LandPredictionTime = DistanceToImpact / TraceLength;
+	}
 }
 
 FALSLeanAmount UALSCharacterAnimInstance::CalculateAirLeanAmount() const
@@ -756,10 +1737,18 @@ FALSLeanAmount UALSCharacterAnimInstance::CalculateAirLeanAmount() const
 	// The Lean In Air curve gets the Fall Speed and is used as a multiplier to smoothly reverse the leaning direction
 	// when transitioning from moving upwards to moving downwards.
 	FALSLeanAmount CalcLeanAmount;
+	if (GameThreadValues.bHasKernelOutput)
+	{
+		const float LeanInAir = LeanInAirLUT.GetValue(InAir.FallSpeed);
+		CalcLeanAmount.LR = KernelOutput.AirLean.LR * LeanInAir;
+		CalcLeanAmount.FB = KernelOutput.AirLean.FB * LeanInAir;
+		return CalcLeanAmount;
+	}
+
 	const FVector& UnrotatedVel = CharacterInformation.CharacterActorRotation.UnrotateVector(
 		CharacterInformation.Velocity) / 350.0f;
 	FVector2D InversedVect(UnrotatedVel.Y, UnrotatedVel.X);
-	InversedVect *= LeanInAirCurve->GetFloatValue(InAir.FallSpeed);
+	InversedVect *= LeanInAirLUT.GetValue(InAir.FallSpeed);
 	CalcLeanAmount.LR = InversedVect.X;
 	CalcLeanAmount.FB = InversedVect.Y;
 	return CalcLeanAmount;
@@ -793,32 +1782,32 @@ void UALSCharacterAnimInstance::TurnInPlace(FRotator TargetRotation, float PlayR
 
 	if (Stance.Standing())
 	{
-		if (FMath::Abs(TurnAngle) < TurnInPlaceValues.Turn180Threshold)
+		if (FMath::Abs(TurnAngle) < TurnInPlace->Turn180Threshold)
 		{
 			TargetTurnAsset = TurnAngle < 0.0f
-				                  ? TurnInPlaceValues.N_TurnIP_L90
-				                  : TurnInPlaceValues.N_TurnIP_R90;
+				                  ? TurnInPlace->N_TurnIP_L90
+				                  : TurnInPlace->N_TurnIP_R90;
 		}
 		else
 		{
 			TargetTurnAsset = TurnAngle < 0.0f
-				                  ? TurnInPlaceValues.N_TurnIP_L180
-				                  : TurnInPlaceValues.N_TurnIP_R180;
+				                  ? TurnInPlace->N_TurnIP_L180
+				                  : TurnInPlace->N_TurnIP_R180;
 		}
 	}
 	else
 	{
-		if (FMath::Abs(TurnAngle) < TurnInPlaceValues.Turn180Threshold)
+		if (FMath::Abs(TurnAngle) < TurnInPlace->Turn180Threshold)
 		{
 			TargetTurnAsset = TurnAngle < 0.0f
-				                  ? TurnInPlaceValues.CLF_TurnIP_L90
-				                  : TurnInPlaceValues.CLF_TurnIP_R90;
+				                  ? TurnInPlace->CLF_TurnIP_L90
+				                  : TurnInPlace->CLF_TurnIP_R90;
 		}
 		else
 		{
 			TargetTurnAsset = TurnAngle < 0.0f
-				                  ? TurnInPlaceValues.CLF_TurnIP_L180
-				                  : TurnInPlaceValues.CLF_TurnIP_R180;
+				                  ? TurnInPlace->CLF_TurnIP_L180
+				                  : TurnInPlace->CLF_TurnIP_R180;
 		}
 	}
 
@@ -846,17 +1835,11 @@ void UALSCharacterAnimInstance::OnJumped()
 	InAir.bJumped = true;
 	InAir.JumpPlayRate = FMath::GetMappedRangeValueClamped({0.0f, 600.0f}, {1.2f, 1.5f}, CharacterInformation.Speed);
 
-	UWorld* World = GetWorld();
-	check(World);
-	World->GetTimerManager().SetTimer(OnJumpedTimer, this,
-	                                  &UALSCharacterAnimInstance::OnJumpedDelay, 0.1f, false);
+	UALSDeadlineSubsystem::Schedule(this, OnJumpedDeadline, 0.1f);
 }
 
 void UALSCharacterAnimInstance::OnPivot()
 {
-	Grounded.bPivot = CharacterInformation.Speed < Config.TriggerPivotSpeedLimit;
-	UWorld* World = GetWorld();
-	check(World);
-	World->GetTimerManager().SetTimer(OnPivotTimer, this,
-	                                  &UALSCharacterAnimInstance::OnPivotDelay, 0.1f, false);
+	Grounded.bPivot = CharacterInformation.Speed < Config->TriggerPivotSpeedLimit;
+	UALSDeadlineSubsystem::Schedule(this, OnPivotDeadline, 0.1f);
 }
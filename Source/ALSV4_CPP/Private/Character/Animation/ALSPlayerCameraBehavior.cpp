@@ -11,9 +11,30 @@
 
 #include "Character/ALSBaseCharacter.h"
 
+void UALSPlayerCameraBehavior::NativeUpdateAnimation(float DeltaSeconds)
+{
+	Super::NativeUpdateAnimation(DeltaSeconds);
+
+	if (ControlledCharacter)
+	{
+		SetFrameState(ControlledCharacter->GetFrameState());
+	}
+}
+
 void UALSPlayerCameraBehavior::SetRotationMode(EALSRotationMode RotationMode)
 {
 	bVelocityDirection = RotationMode == EALSRotationMode::VelocityDirection;
 	bLookingDirection = RotationMode == EALSRotationMode::LookingDirection;
 	bAiming = RotationMode == EALSRotationMode::Aiming;
 }
+
+void UALSPlayerCameraBehavior::SetFrameState(const FALSCharacterFrameState& State)
+{
+	MovementState = State.MovementState;
+	MovementAction = State.MovementAction;
+	bRightShoulder = State.bRightShoulder;
+	Gait = State.Gait;
+	SetRotationMode(State.RotationMode);
+	Stance = State.Stance;
+	ViewMode = State.ViewMode;
+}
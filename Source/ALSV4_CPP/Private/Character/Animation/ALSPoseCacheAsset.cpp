@@ -0,0 +1,192 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Character/Animation/ALSPoseCacheAsset.h"
+
+namespace ALSPoseCache
+{
+	constexpr float QuantizeScale = 32767.0f;
+
+	void AddSample(TArray<FALSPoseCacheSample, TInlineAllocator<4>>& Samples, int32 Cycle, float Weight)
+	{
+		if (Cycle == INDEX_NONE || Weight <= 0.0f)
+		{
+			return;
+		}
+
+		for (FALSPoseCacheSample& Sample : Samples)
+		{
+			if (Sample.Cycle == Cycle)
+			{
+				Sample.Weight += Weight;
+				return;
+			}
+		}
+
+		Samples.Add({Cycle, Weight});
+	}
+}
+
+void UALSPoseCacheAsset::FindSamples(EALSGait Gait, EALSStance Stance, EALSOverlayState OverlayState, float Speed,
+                                     float Direction, TArray<FALSPoseCacheSample, TInlineAllocator<4>>& OutSamples,
+                                     float& OutPlayRate) const
+{
+	OutSamples.Reset();
+	OutPlayRate = 1.0f;
+
+	// Closest captured directions on both sides of the requested one, as signed angles from it
+	int32 IdleCycle = INDEX_NONE;
+	float LowerDelta = -MAX_flt;
+	float UpperDelta = MAX_flt;
+	bool bHasLower = false;
+	bool bHasUpper = false;
+	for (int32 Index = 0; Index < Cycles.Num(); ++Index)
+	{
+		const FALSPoseCacheCycle& Cycle = Cycles[Index];
+		if (Cycle.Stance != Stance || Cycle.OverlayState != OverlayState)
+		{
+			continue;
+		}
+
+		if (Cycle.IsIdle())
+		{
+			IdleCycle = Index;
+			continue;
+		}
+
+		if (Cycle.Gait != Gait)
+		{
+			continue;
+		}
+
+		const float Delta = FRotator::NormalizeAxis(Cycle.Direction - Direction);
+		if (Delta <= 0.0f && Delta > LowerDelta)
+		{
+			LowerDelta = Delta;
+			bHasLower = true;
+		}
+		if (Delta >= 0.0f && Delta < UpperDelta)
+		{
+			UpperDelta = Delta;
+			bHasUpper = true;
+		}
+	}
+
+	if (!bHasLower && !bHasUpper)
+	{
+		ALSPoseCache::AddSample(OutSamples, IdleCycle, 1.0f);
+		return;
+	}
+
+	float UpperWeight = bHasUpper ? 1.0f : 0.0f;
+	if (bHasLower && bHasUpper && UpperDelta - LowerDelta > KINDA_SMALL_NUMBER)
+	{
+		UpperWeight = -LowerDelta / (UpperDelta - LowerDelta);
+	}
+
+	const float DirectionDeltas[2] = {LowerDelta, UpperDelta};
+	const float DirectionWeights[2] = {1.0f - UpperWeight, UpperWeight};
+	float PlayRate = 0.0f;
+	for (int32 Side = 0; Side < 2; ++Side)
+	{
+		if (DirectionWeights[Side] <= 0.0f)
+		{
+			continue;
+		}
+
+		// Slowest and fastest cycles of the direction, and the two closest around the requested speed
+		const float CycleDirection = FRotator::NormalizeAxis(Direction + DirectionDeltas[Side]);
+		int32 Slower = INDEX_NONE;
+		int32 Faster = INDEX_NONE;
+		int32 Slowest = INDEX_NONE;
+		int32 Fastest = INDEX_NONE;
+		for (int32 Index = 0; Index < Cycles.Num(); ++Index)
+		{
+			const FALSPoseCacheCycle& Cycle = Cycles[Index];
+			if (Cycle.IsIdle() || Cycle.Gait != Gait || Cycle.Stance != Stance ||
+				Cycle.OverlayState != OverlayState ||
+				!FMath::IsNearlyEqual(FRotator::NormalizeAxis(Cycle.Direction - CycleDirection), 0.0f, 0.5f))
+			{
+				continue;
+			}
+
+			if (Slowest == INDEX_NONE || Cycle.Speed < Cycles[Slowest].Speed)
+			{
+				Slowest = Index;
+			}
+			if (Fastest == INDEX_NONE || Cycle.Speed > Cycles[Fastest].Speed)
+			{
+				Fastest = Index;
+			}
+			if (Cycle.Speed <= Speed && (Slower == INDEX_NONE || Cycle.Speed > Cycles[Slower].Speed))
+			{
+				Slower = Index;
+			}
+			if (Cycle.Speed >= Speed && (Faster == INDEX_NONE || Cycle.Speed < Cycles[Faster].Speed))
+			{
+				Faster = Index;
+			}
+		}
+
+		const float Weight = DirectionWeights[Side];
+		if (Faster == INDEX_NONE)
+		{
+			// Faster than captured, ALS speeds up the cycle the same way through the play rate
+			ALSPoseCache::AddSample(OutSamples, Fastest, Weight);
+			PlayRate += Weight * Speed / Cycles[Fastest].Speed;
+		}
+		else if (Slower == INDEX_NONE)
+		{
+			// Slower than captured, blend in the idle cycle
+			const float MoveAlpha = IdleCycle != INDEX_NONE ? Speed / Cycles[Slowest].Speed : 1.0f;
+			ALSPoseCache::AddSample(OutSamples, Slowest, Weight * MoveAlpha);
+			ALSPoseCache::AddSample(OutSamples, IdleCycle, Weight * (1.0f - MoveAlpha));
+			PlayRate += Weight;
+		}
+		else
+		{
+			const float SpeedRange = Cycles[Faster].Speed - Cycles[Slower].Speed;
+			const float FasterAlpha = SpeedRange > KINDA_SMALL_NUMBER
+				                          ? (Speed - Cycles[Slower].Speed) / SpeedRange
+				                          : 1.0f;
+			ALSPoseCache::AddSample(OutSamples, Slower, Weight * (1.0f - FasterAlpha));
+			ALSPoseCache::AddSample(OutSamples, Faster, Weight * FasterAlpha);
+			PlayRate += Weight;
+		}
+	}
+
+	OutPlayRate = PlayRate;
+}
+
+FQuat UALSPoseCacheAsset::GetRotation(const FALSPoseCacheCycle& Cycle, int32 Frame, int32 Bone) const
+{
+	return DequantizeRotation(&Cycle.Rotations[(Frame * BoneNames.Num() + Bone) * 3]);
+}
+
+void UALSPoseCacheAsset::QuantizeRotation(const FQuat& Rotation, int16* OutComponents)
+{
+	// Both hemispheres describe the same rotation, keeping W positive lets it be rebuilt from the others
+	FQuat Quat = Rotation.GetNormalized();
+	if (Quat.W < 0.0f)
+	{
+		Quat = -Quat;
+	}
+
+	OutComponents[0] = static_cast<int16>(FMath::RoundToInt(Quat.X * ALSPoseCache::QuantizeScale));
+	OutComponents[1] = static_cast<int16>(FMath::RoundToInt(Quat.Y * ALSPoseCache::QuantizeScale));
+	OutComponents[2] = static_cast<int16>(FMath::RoundToInt(Quat.Z * ALSPoseCache::QuantizeScale));
+}
+
+FQuat UALSPoseCacheAsset::DequantizeRotation(const int16* Components)
+{
+	const float X = Components[0] / ALSPoseCache::QuantizeScale;
+	const float Y = Components[1] / ALSPoseCache::QuantizeScale;
+	const float Z = Components[2] / ALSPoseCache::QuantizeScale;
+	const float W = FMath::Sqrt(FMath::Max(0.0f, 1.0f - X * X - Y * Y - Z * Z));
+	return FQuat(X, Y, Z, W).GetNormalized();
+}
@@ -0,0 +1,307 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Character/Animation/AnimNode/AnimNode_ALSFootIK.h"
+#include "Animation/AnimInstanceProxy.h"
+#include "Character/Animation/ALSAnimCurveCache.h"
+#include "Character/Animation/ALSCharacterAnimInstance.h"
+#include "Library/ALSMathLibrary.h"
+
+FAnimNode_ALSFootIK::FAnimNode_ALSFootIK()
+{
+	IKFootBone_L.BoneName = FName(TEXT("ik_foot_l"));
+	IKFootBone_R.BoneName = FName(TEXT("ik_foot_r"));
+	PelvisBone.BoneName = FName(TEXT("pelvis"));
+
+	for (SmartName::UID_Type& UID : CurveUIDs)
+	{
+		UID = SmartName::MaxUID;
+	}
+}
+
+void FAnimNode_ALSFootIK::Initialize_AnyThread(const FAnimationInitializeContext& Context)
+{
+	Super::Initialize_AnyThread(Context);
+
+	FootIKValues = FALSAnimGraphFootIK();
+	PendingDeltaTime = 0.0f;
+}
+
+void FAnimNode_ALSFootIK::GatherDebugData(FNodeDebugData& DebugData)
+{
+	FString DebugLine = DebugData.GetNodeName(this);
+	DebugLine += FString::Printf(TEXT("(Lock L: %.2f, Lock R: %.2f, Pelvis: %.2f)"), FootIKValues.FootLock_L_Alpha,
+	                             FootIKValues.FootLock_R_Alpha, FootIKValues.PelvisAlpha);
+	DebugData.AddDebugItem(DebugLine);
+
+	ComponentPose.GatherDebugData(DebugData);
+}
+
+void FAnimNode_ALSFootIK::UpdateInternal(const FAnimationUpdateContext& Context)
+{
+	Super::UpdateInternal(Context);
+
+	// Foot placement is cosmetic, the server anim mode leaves the pose as is
+	const UALSCharacterAnimInstance* AnimInstance =
+		Cast<UALSCharacterAnimInstance>(Context.AnimInstanceProxy->GetAnimInstanceObject());
+	bSkipped = AnimInstance && AnimInstance->IsServerAnimMode();
+	if (bSkipped)
+	{
+		return;
+	}
+
+	// State is advanced on evaluation, where the pose is available
+	PendingDeltaTime += Context.GetDeltaTime();
+}
+
+void FAnimNode_ALSFootIK::InitializeBoneReferences(const FBoneContainer& RequiredBones)
+{
+	IKFootBone_L.Initialize(RequiredBones);
+	IKFootBone_R.Initialize(RequiredBones);
+	PelvisBone.Initialize(RequiredBones);
+
+	const USkeleton* Skeleton = RequiredBones.GetSkeletonAsset();
+	if (!Skeleton)
+	{
+		return;
+	}
+
+	const EALSAnimCurve Curves[Curve_Num] =
+	{
+		EALSAnimCurve::Enable_FootIK_L,
+		EALSAnimCurve::Enable_FootIK_R,
+		EALSAnimCurve::FootLock_L,
+		EALSAnimCurve::FootLock_R,
+		EALSAnimCurve::RotationAmount
+	};
+
+	for (int32 Index = 0; Index < Curve_Num; ++Index)
+	{
+		CurveUIDs[Index] = Skeleton->GetUIDByName(USkeleton::AnimCurveMappingName,
+		                                          FALSAnimCurveCache::GetCurveName(Curves[Index]));
+	}
+}
+
+bool FAnimNode_ALSFootIK::IsValidToEvaluate(const USkeleton* Skeleton, const FBoneContainer& RequiredBones)
+{
+	return IKFootBone_L.IsValidToEvaluate(RequiredBones) &&
+		IKFootBone_R.IsValidToEvaluate(RequiredBones) &&
+		PelvisBone.IsValidToEvaluate(RequiredBones);
+}
+
+float FAnimNode_ALSFootIK::GetCurveValue(const FComponentSpacePoseContext& Output, ECurve Curve) const
+{
+	const SmartName::UID_Type UID = CurveUIDs[Curve];
+	return UID != SmartName::MaxUID ? Output.Curve.Get(UID) : 0.0f;
+}
+
+void FAnimNode_ALSFootIK::EvaluateSkeletalControl_AnyThread(FComponentSpacePoseContext& Output,
+                                                            TArray<FBoneTransform>& OutBoneTransforms)
+{
+	if (bSkipped)
+	{
+		return;
+	}
+
+	const float DeltaSeconds = PendingDeltaTime;
+	PendingDeltaTime = 0.0f;
+
+	const FBoneContainer& BoneContainer = Output.Pose.GetPose().GetBoneContainer();
+	const FCompactPoseBoneIndex FootIndex_L = IKFootBone_L.GetCompactPoseIndex(BoneContainer);
+	const FCompactPoseBoneIndex FootIndex_R = IKFootBone_R.GetCompactPoseIndex(BoneContainer);
+	const FCompactPoseBoneIndex PelvisIndex = PelvisBone.GetCompactPoseIndex(BoneContainer);
+
+	const FTransform& IKFoot_L = Output.Pose.GetComponentSpaceTransform(FootIndex_L);
+	const FTransform& IKFoot_R = Output.Pose.GetComponentSpaceTransform(FootIndex_R);
+
+	const float EnableFootIK_L = GetCurveValue(Output, Curve_EnableFootIK_L);
+	const float EnableFootIK_R = GetCurveValue(Output, Curve_EnableFootIK_R);
+	const float RotationAmount = GetCurveValue(Output, Curve_RotationAmount);
+
+	// Update Foot Locking values.
+	SetFootLocking(DeltaSeconds, EnableFootIK_L, GetCurveValue(Output, Curve_FootLock_L), RotationAmount, IKFoot_L,
+	               FootIKValues.FootLock_L_Alpha, FootIKValues.UseFootLockCurve_L,
+	               FootIKValues.FootLock_L_Location, FootIKValues.FootLock_L_Rotation);
+	SetFootLocking(DeltaSeconds, EnableFootIK_R, GetCurveValue(Output, Curve_FootLock_R), RotationAmount, IKFoot_R,
+	               FootIKValues.FootLock_R_Alpha, FootIKValues.UseFootLockCurve_R,
+	               FootIKValues.FootLock_R_Location, FootIKValues.FootLock_R_Rotation);
+
+	if (Inputs.bInAir)
+	{
+		// Reset IK Offsets if In Air
+		SetPelvisIKOffset(DeltaSeconds, EnableFootIK_L, EnableFootIK_R, FVector::ZeroVector, FVector::ZeroVector);
+		ResetIKOffsets(DeltaSeconds);
+	}
+	else if (!Inputs.bRagdoll)
+	{
+		// Update all Foot Lock and Foot Offset values when not In Air
+		SetFootOffsets(DeltaSeconds, EnableFootIK_L, Inputs.FootOffset_L_Target, Inputs.FootOffset_L_RotationTarget,
+		               FootIKValues.FootOffset_L_Location, FootIKValues.FootOffset_L_Rotation);
+		SetFootOffsets(DeltaSeconds, EnableFootIK_R, Inputs.FootOffset_R_Target, Inputs.FootOffset_R_RotationTarget,
+		               FootIKValues.FootOffset_R_Location, FootIKValues.FootOffset_R_Rotation);
+		SetPelvisIKOffset(DeltaSeconds, EnableFootIK_L, EnableFootIK_R,
+		                  Inputs.FootOffset_L_Target, Inputs.FootOffset_R_Target);
+	}
+
+	// Offsets are traced in world space, lock values are in component space
+	const FQuat ComponentRotation = Output.AnimInstanceProxy->GetComponentTransform().GetRotation();
+
+	OutBoneTransforms.Add(FBoneTransform(FootIndex_L, ApplyFoot(
+		IKFoot_L, ComponentRotation, FootIKValues.FootLock_L_Alpha, FootIKValues.FootLock_L_Location,
+		FootIKValues.FootLock_L_Rotation, FootIKValues.FootOffset_L_Location, FootIKValues.FootOffset_L_Rotation)));
+	OutBoneTransforms.Add(FBoneTransform(FootIndex_R, ApplyFoot(
+		IKFoot_R, ComponentRotation, FootIKValues.FootLock_R_Alpha, FootIKValues.FootLock_R_Location,
+		FootIKValues.FootLock_R_Rotation, FootIKValues.FootOffset_R_Location, FootIKValues.FootOffset_R_Rotation)));
+
+	if (bApplyPelvisOffset && FootIKValues.PelvisAlpha > 0.0f)
+	{
+		FTransform Pelvis = Output.Pose.GetComponentSpaceTransform(PelvisIndex);
+		Pelvis.AddToTranslation(ComponentRotation.UnrotateVector(FootIKValues.PelvisOffset) * FootIKValues.PelvisAlpha);
+		OutBoneTransforms.Add(FBoneTransform(PelvisIndex, Pelvis));
+	}
+
+	OutBoneTransforms.Sort(FCompareBoneTransformIndex());
+}
+
+FTransform FAnimNode_ALSFootIK::ApplyFoot(const FTransform& IKFootTransform, const FQuat& ComponentRotation,
+                                          float FootLockAlpha, const FVector& FootLockLocation,
+                                          const FRotator& FootLockRotation, const FVector& FootOffsetLocation,
+                                          const FRotator& FootOffsetRotation) const
+{
+	FTransform Result = IKFootTransform;
+
+	if (bApplyFootLocking && FootLockAlpha > 0.0f)
+	{
+		Result.SetLocation(FMath::Lerp(Result.GetLocation(), FootLockLocation, FootLockAlpha));
+		Result.SetRotation(FQuat::Slerp(Result.GetRotation(), FootLockRotation.Quaternion(), FootLockAlpha));
+	}
+
+	if (bApplyFootOffsets)
+	{
+		// Rotate the world space offsets into component space before adding them
+		const FQuat OffsetRotation = ComponentRotation.Inverse() * FootOffsetRotation.Quaternion() * ComponentRotation;
+		Result.AddToTranslation(ComponentRotation.UnrotateVector(FootOffsetLocation));
+		Result.SetRotation((OffsetRotation * Result.GetRotation()).GetNormalized());
+	}
+
+	return Result;
+}
+
+void FAnimNode_ALSFootIK::SetFootLocking(float DeltaSeconds, float EnableFootIK, float FootLock, float RotationAmount,
+                                         const FTransform& IKFootTransform, float& CurFootLockAlpha,
+                                         bool& UseFootLockCurve, FVector& CurFootLockLoc,
+                                         FRotator& CurFootLockRot) const
+{
+	if (EnableFootIK <= 0.0f)
+	{
+		return;
+	}
+
+	// Step 1: Set Local FootLock Curve value
+	float FootLockCurveVal;
+
+	if (UseFootLockCurve)
+	{
+		UseFootLockCurve = FMath::Abs(RotationAmount) <= 0.001f || !Inputs.bIsAutonomousProxy;
+		FootLockCurveVal = FootLock * Inputs.UpdateRateScale;
+	}
+	else
+	{
+		UseFootLockCurve = FootLock >= 0.99f;
+		FootLockCurveVal = 0.0f;
+	}
+
+	// Step 2: Only update the FootLock Alpha if the new value is less than the current, or it equals 1. This makes it
+	// so that the foot can only blend out of the locked position or lock to a new position, and never blend in.
+	if (FootLockCurveVal >= 0.99f || FootLockCurveVal < CurFootLockAlpha)
+	{
+		CurFootLockAlpha = FootLockCurveVal;
+	}
+
+	// Step 3: If the Foot Lock curve equals 1, save the new lock location and rotation in component space as the target.
+	if (CurFootLockAlpha >= 0.99f)
+	{
+		CurFootLockLoc = IKFootTransform.GetLocation();
+		CurFootLockRot = IKFootTransform.Rotator();
+	}
+
+	// Step 4: If the Foot Lock Alpha has a weight,
+	// update the Foot Lock offsets to keep the foot planted in place while the capsule moves.
+	if (CurFootLockAlpha > 0.0f)
+	{
+		SetFootLockOffsets(DeltaSeconds, CurFootLockLoc, CurFootLockRot);
+	}
+}
+
+void FAnimNode_ALSFootIK::SetFootLockOffsets(float DeltaSeconds, FVector& LocalLoc, FRotator& LocalRot) const
+{
+	// Subtract the distance traveled between frames from the current local location and rotate
+	// it by the rotation difference to keep the foot planted in component space.
+	LocalLoc = (LocalLoc - Inputs.LocalVelocity * DeltaSeconds).RotateAngleAxis(
+		Inputs.RotationDifference.Yaw, FVector::DownVector);
+
+	// Subtract the Rotation Difference from the current Local Rotation to get the new local rotation.
+	FRotator Delta = LocalRot - Inputs.RotationDifference;
+	Delta.Normalize();
+	LocalRot = Delta;
+}
+
+void FAnimNode_ALSFootIK::SetFootOffsets(float DeltaSeconds, float EnableFootIK, const FVector& LocationTarget,
+                                         const FRotator& RotationTarget, FVector& CurLocationOffset,
+                                         FRotator& CurRotationOffset) const
+{
+	// Only update Foot IK offset values if the Foot IK curve has a weight. If it equals 0, clear the offset values.
+	if (EnableFootIK <= 0)
+	{
+		CurLocationOffset = FVector::ZeroVector;
+		CurRotationOffset = FRotator::ZeroRotator;
+		return;
+	}
+
+	// Interpolate at different speeds based on whether the new target is above or below the current one.
+	const float InterpSpeed = CurLocationOffset.Z > LocationTarget.Z ? 30.f : 15.0f;
+	CurLocationOffset = UALSMathLibrary::VInterpToSubstepped(CurLocationOffset, LocationTarget, DeltaSeconds,
+	                                                         InterpSpeed, MaxInterpSubstep);
+	CurRotationOffset = UALSMathLibrary::RInterpToSubstepped(CurRotationOffset, RotationTarget, DeltaSeconds, 30.0f,
+	                                                         MaxInterpSubstep);
+}
+
+void FAnimNode_ALSFootIK::SetPelvisIKOffset(float DeltaSeconds, float EnableFootIK_L, float EnableFootIK_R,
+                                            const FVector& FootOffsetLTarget, const FVector& FootOffsetRTarget)
+{
+	// Calculate the Pelvis Alpha by finding the average Foot IK weight. If the alpha is 0, clear the offset.
+	FootIKValues.PelvisAlpha = (EnableFootIK_L + EnableFootIK_R) / 2.0f;
+
+	if (FootIKValues.PelvisAlpha > 0.0f)
+	{
+		// Set the new Pelvis Target to be the lowest Foot Offset, and interpolate at different speeds
+		// based on whether the new target is above or below the current one.
+		const FVector PelvisTarget = FootOffsetLTarget.Z < FootOffsetRTarget.Z ? FootOffsetLTarget : FootOffsetRTarget;
+		const float InterpSpeed = PelvisTarget.Z > FootIKValues.PelvisOffset.Z ? 10.0f : 15.0f;
+		FootIKValues.PelvisOffset =
+			UALSMathLibrary::VInterpToSubstepped(FootIKValues.PelvisOffset, PelvisTarget, DeltaSeconds, InterpSpeed,
+			                                     MaxInterpSubstep);
+	}
+	else
+	{
+		FootIKValues.PelvisOffset = FVector::ZeroVector;
+	}
+}
+
+void FAnimNode_ALSFootIK::ResetIKOffsets(float DeltaSeconds)
+{
+	// Interp Foot IK offsets back to 0
+	FootIKValues.FootOffset_L_Location = UALSMathLibrary::VInterpToSubstepped(
+		FootIKValues.FootOffset_L_Location, FVector::ZeroVector, DeltaSeconds, 15.0f, MaxInterpSubstep);
+	FootIKValues.FootOffset_R_Location = UALSMathLibrary::VInterpToSubstepped(
+		FootIKValues.FootOffset_R_Location, FVector::ZeroVector, DeltaSeconds, 15.0f, MaxInterpSubstep);
+	FootIKValues.FootOffset_L_Rotation = UALSMathLibrary::RInterpToSubstepped(
+		FootIKValues.FootOffset_L_Rotation, FRotator::ZeroRotator, DeltaSeconds, 15.0f, MaxInterpSubstep);
+	FootIKValues.FootOffset_R_Rotation = UALSMathLibrary::RInterpToSubstepped(
+		FootIKValues.FootOffset_R_Rotation, FRotator::ZeroRotator, DeltaSeconds, 15.0f, MaxInterpSubstep);
+}
@@ -0,0 +1,321 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Character/Animation/AnimNode/AnimNode_ALSLayering.h"
+#include "Animation/AnimInstanceProxy.h"
+#include "Character/Animation/ALSAnimCurveCache.h"
+#include "Character/Animation/ALSCharacterAnimInstance.h"
+
+namespace ALSLayering
+{
+	/** Curve of each ECurve, names come from the curve cache */
+	const EALSAnimCurve Curves[] =
+	{
+		EALSAnimCurve::BasePose_N,
+		EALSAnimCurve::BasePose_CLF,
+		EALSAnimCurve::Layering_Legs,
+		EALSAnimCurve::Layering_Legs_Add,
+		EALSAnimCurve::Layering_Pelvis,
+		EALSAnimCurve::Layering_Pelvis_Add,
+		EALSAnimCurve::Layering_Spine,
+		EALSAnimCurve::Layering_Spine_Add,
+		EALSAnimCurve::Layering_Head,
+		EALSAnimCurve::Layering_Head_Add,
+		EALSAnimCurve::Layering_Arm_L,
+		EALSAnimCurve::Layering_Arm_L_Add,
+		EALSAnimCurve::Layering_Arm_L_LS,
+		EALSAnimCurve::Layering_Arm_R,
+		EALSAnimCurve::Layering_Arm_R_Add,
+		EALSAnimCurve::Layering_Arm_R_LS,
+		EALSAnimCurve::Layering_Hand_L,
+		EALSAnimCurve::Layering_Hand_R
+	};
+}
+
+FAnimNode_ALSLayering::FAnimNode_ALSLayering()
+{
+	static_assert(UE_ARRAY_COUNT(ALSLayering::Curves) == Curve_Num, "Curves don't match ECurve");
+
+	for (SmartName::UID_Type& UID : CurveUIDs)
+	{
+		UID = SmartName::MaxUID;
+	}
+}
+
+void FAnimNode_ALSLayering::Initialize_AnyThread(const FAnimationInitializeContext& Context)
+{
+	FAnimNode_Base::Initialize_AnyThread(Context);
+
+	BaseLayer.Initialize(Context);
+	OverlayLayer.Initialize(Context);
+	BasePose_N.Initialize(Context);
+	BasePose_CLF.Initialize(Context);
+}
+
+void FAnimNode_ALSLayering::CacheBones_AnyThread(const FAnimationCacheBonesContext& Context)
+{
+	BaseLayer.CacheBones(Context);
+	OverlayLayer.CacheBones(Context);
+	BasePose_N.CacheBones(Context);
+	BasePose_CLF.CacheBones(Context);
+
+	const FBoneContainer& RequiredBones = Context.AnimInstanceProxy->GetRequiredBones();
+	CacheBodyParts(RequiredBones);
+
+	const USkeleton* Skeleton = RequiredBones.GetSkeletonAsset();
+	for (int32 Index = 0; Index < Curve_Num; ++Index)
+	{
+		const FName CurveName = FALSAnimCurveCache::GetCurveName(ALSLayering::Curves[Index]);
+		CurveUIDs[Index] = Skeleton
+			                   ? Skeleton->GetUIDByName(USkeleton::AnimCurveMappingName, CurveName)
+			                   : SmartName::MaxUID;
+	}
+}
+
+void FAnimNode_ALSLayering::CacheBodyParts(const FBoneContainer& RequiredBones)
+{
+	const TPair<FName, EBodyPart> BodyPartRoots[] =
+	{
+		{PelvisBone, BodyPart_Pelvis},
+		{ThighBone_L, BodyPart_Legs},
+		{ThighBone_R, BodyPart_Legs},
+		{SpineBone, BodyPart_Spine},
+		{HeadBone, BodyPart_Head},
+		{ClavicleBone_L, BodyPart_Arm_L},
+		{ClavicleBone_R, BodyPart_Arm_R},
+		{HandBone_L, BodyPart_Hand_L},
+		{HandBone_R, BodyPart_Hand_R}
+	};
+
+	const FReferenceSkeleton& RefSkeleton = RequiredBones.GetReferenceSkeleton();
+	const TArray<FBoneIndexType>& BoneIndices = RequiredBones.GetBoneIndicesArray();
+
+	// Required bones are sorted parent first, so body part of the parent is always known
+	BodyParts.Reset(BoneIndices.Num());
+	for (int32 CompactIndex = 0; CompactIndex < BoneIndices.Num(); ++CompactIndex)
+	{
+		const int32 SkeletonIndex = BoneIndices[CompactIndex];
+		const FName BoneName = RefSkeleton.GetBoneName(SkeletonIndex);
+
+		uint8 BodyPart = BodyPart_None;
+		const FCompactPoseBoneIndex ParentIndex =
+			RequiredBones.GetParentBoneIndex(FCompactPoseBoneIndex(CompactIndex));
+		if (ParentIndex != INDEX_NONE)
+		{
+			BodyPart = BodyParts[ParentIndex.GetInt()];
+		}
+
+		for (const TPair<FName, EBodyPart>& Root : BodyPartRoots)
+		{
+			if (Root.Key == BoneName)
+			{
+				BodyPart = Root.Value;
+				break;
+			}
+		}
+
+		BodyParts.Add(BodyPart);
+	}
+}
+
+void FAnimNode_ALSLayering::Update_AnyThread(const FAnimationUpdateContext& Context)
+{
+	GetEvaluateGraphExposedInputs().Execute(Context);
+
+	// The server anim mode only needs the curves of the base layer, overlays are cosmetic
+	const UALSCharacterAnimInstance* AnimInstance =
+		Cast<UALSCharacterAnimInstance>(Context.AnimInstanceProxy->GetAnimInstanceObject());
+	bBaseLayerOnly = AnimInstance && AnimInstance->IsServerAnimMode();
+
+	BaseLayer.Update(Context);
+	if (bBaseLayerOnly)
+	{
+		return;
+	}
+
+	OverlayLayer.Update(Context);
+	BasePose_N.Update(Context);
+	BasePose_CLF.Update(Context);
+}
+
+float FAnimNode_ALSLayering::GetCurveValue(const FBlendedCurve& Curve, SmartName::UID_Type UID)
+{
+	return UID != SmartName::MaxUID ? Curve.Get(UID) : 0.0f;
+}
+
+void FAnimNode_ALSLayering::Evaluate_AnyThread(FPoseContext& Output)
+{
+	BaseLayer.Evaluate(Output);
+	if (bBaseLayerOnly)
+	{
+		return;
+	}
+
+	FPoseContext OverlayContext(Output);
+	OverlayLayer.Evaluate(OverlayContext);
+
+	const FBlendedCurve& Curves = OverlayContext.Curve;
+
+	// Base pose of the base layer, the additive applied to the overlay is the difference of the base layer to it
+	FPoseContext ReferenceContext(Output);
+	const float CLFWeight = FMath::Clamp(GetCurveValue(Output.Curve, CurveUIDs[Curve_BasePose_CLF]), 0.0f, 1.0f);
+	if (CLFWeight >= 1.0f)
+	{
+		BasePose_CLF.Evaluate(ReferenceContext);
+	}
+	else
+	{
+		BasePose_N.Evaluate(ReferenceContext);
+		if (CLFWeight > 0.0f)
+		{
+			FPoseContext CLFContext(Output);
+			BasePose_CLF.Evaluate(CLFContext);
+			for (FCompactPoseBoneIndex BoneIndex : ReferenceContext.Pose.ForEachBoneIndex())
+			{
+				ReferenceContext.Pose[BoneIndex].BlendWith(CLFContext.Pose[BoneIndex], CLFWeight);
+			}
+		}
+	}
+
+	// Weights of each body part. The arms use mesh space additive unless the local space curve is fully weighted.
+	FBodyPartWeights Weights[BodyPart_Num];
+	Weights[BodyPart_Legs].Overlay = GetCurveValue(Curves, CurveUIDs[Curve_Legs]);
+	Weights[BodyPart_Legs].AdditiveLS = GetCurveValue(Curves, CurveUIDs[Curve_Legs_Add]);
+	Weights[BodyPart_Pelvis].Overlay = GetCurveValue(Curves, CurveUIDs[Curve_Pelvis]);
+	Weights[BodyPart_Pelvis].AdditiveLS = GetCurveValue(Curves, CurveUIDs[Curve_Pelvis_Add]);
+	Weights[BodyPart_Spine].Overlay = GetCurveValue(Curves, CurveUIDs[Curve_Spine]);
+	Weights[BodyPart_Spine].AdditiveMS = GetCurveValue(Curves, CurveUIDs[Curve_Spine_Add]);
+	Weights[BodyPart_Head].Overlay = GetCurveValue(Curves, CurveUIDs[Curve_Head]);
+	Weights[BodyPart_Head].AdditiveLS = GetCurveValue(Curves, CurveUIDs[Curve_Head_Add]);
+
+	const float Arm_L_Add = GetCurveValue(Curves, CurveUIDs[Curve_Arm_L_Add]);
+	const float Arm_L_LS = GetCurveValue(Curves, CurveUIDs[Curve_Arm_L_LS]);
+	Weights[BodyPart_Arm_L].Overlay = GetCurveValue(Curves, CurveUIDs[Curve_Arm_L]);
+	Weights[BodyPart_Arm_L].AdditiveLS = Arm_L_Add * Arm_L_LS;
+	Weights[BodyPart_Arm_L].AdditiveMS = Arm_L_Add * static_cast<float>(1 - FMath::FloorToInt(Arm_L_LS));
+
+	const float Arm_R_Add = GetCurveValue(Curves, CurveUIDs[Curve_Arm_R_Add]);
+	const float Arm_R_LS = GetCurveValue(Curves, CurveUIDs[Curve_Arm_R_LS]);
+	Weights[BodyPart_Arm_R].Overlay = GetCurveValue(Curves, CurveUIDs[Curve_Arm_R]);
+	Weights[BodyPart_Arm_R].AdditiveLS = Arm_R_Add * Arm_R_LS;
+	Weights[BodyPart_Arm_R].AdditiveMS = Arm_R_Add * static_cast<float>(1 - FMath::FloorToInt(Arm_R_LS));
+
+	// Hands follow the arm additives, but the overlay of the hand pose is weighted separately
+	Weights[BodyPart_Hand_L] = Weights[BodyPart_Arm_L];
+	Weights[BodyPart_Hand_L].Overlay = GetCurveValue(Curves, CurveUIDs[Curve_Hand_L]);
+	Weights[BodyPart_Hand_R] = Weights[BodyPart_Arm_R];
+	Weights[BodyPart_Hand_R].Overlay = GetCurveValue(Curves, CurveUIDs[Curve_Hand_R]);
+
+	LayerPoses(Output.Pose, OverlayContext.Pose, ReferenceContext.Pose, Weights, BodyParts);
+
+	// Layering curves are set by the overlay animations, keep them on the output for the rest of the graph
+	Output.Curve.Combine(OverlayContext.Curve);
+}
+
+void FAnimNode_ALSLayering::LayerPoses(FCompactPose& Pose, const FCompactPose& Overlay, const FCompactPose& Reference,
+                                       const FBodyPartWeights (&Weights)[BodyPart_Num], const TArray<uint8>& BodyParts)
+{
+	bool bNeedsMeshSpace = false;
+	for (const FBodyPartWeights& BodyPartWeights : Weights)
+	{
+		bNeedsMeshSpace |= BodyPartWeights.Overlay > 0.0f && BodyPartWeights.AdditiveMS > 0.0f;
+	}
+
+	// Mesh space additives only need the component space rotations, accumulated parent first in the same pass
+	FMemMark Mark(FMemStack::Get());
+	const int32 NumBones = Pose.GetNumBones();
+	TArray<FQuat, TMemStackAllocator<>> BaseRotationsCS;
+	TArray<FQuat, TMemStackAllocator<>> ReferenceRotationsCS;
+	TArray<FQuat, TMemStackAllocator<>> OverlayRotationsCS;
+	TArray<FQuat, TMemStackAllocator<>> ResultRotationsCS;
+	if (bNeedsMeshSpace)
+	{
+		BaseRotationsCS.SetNumUninitialized(NumBones);
+		ReferenceRotationsCS.SetNumUninitialized(NumBones);
+		OverlayRotationsCS.SetNumUninitialized(NumBones);
+		ResultRotationsCS.SetNumUninitialized(NumBones);
+	}
+
+	for (FCompactPoseBoneIndex BoneIndex : Pose.ForEachBoneIndex())
+	{
+		const int32 Index = BoneIndex.GetInt();
+		const FBodyPartWeights& BodyPartWeights = Weights[BodyParts.IsValidIndex(Index) ? BodyParts[Index] : 0];
+		const FTransform& Base = Pose[BoneIndex];
+		const FTransform& ReferenceBone = Reference[BoneIndex];
+		const FTransform& OverlayBone = Overlay[BoneIndex];
+
+		FQuat ParentResultRotationCS = FQuat::Identity;
+		FQuat ParentOverlayRotationCS = FQuat::Identity;
+		if (bNeedsMeshSpace)
+		{
+			const FCompactPoseBoneIndex ParentIndex = Pose.GetParentBoneIndex(BoneIndex);
+			if (ParentIndex != INDEX_NONE)
+			{
+				const int32 Parent = ParentIndex.GetInt();
+				ParentResultRotationCS = ResultRotationsCS[Parent];
+				ParentOverlayRotationCS = OverlayRotationsCS[Parent];
+				BaseRotationsCS[Index] = BaseRotationsCS[Parent] * Base.GetRotation();
+				ReferenceRotationsCS[Index] = ReferenceRotationsCS[Parent] * ReferenceBone.GetRotation();
+			}
+			else
+			{
+				BaseRotationsCS[Index] = Base.GetRotation();
+				ReferenceRotationsCS[Index] = ReferenceBone.GetRotation();
+			}
+			OverlayRotationsCS[Index] = ParentOverlayRotationCS * OverlayBone.GetRotation();
+		}
+
+		if (BodyPartWeights.Overlay > 0.0f)
+		{
+			FTransform Result = OverlayBone;
+
+			if (BodyPartWeights.AdditiveLS > 0.0f)
+			{
+				FTransform Additive;
+				Additive.SetRotation(Base.GetRotation() * ReferenceBone.GetRotation().Inverse());
+				Additive.SetTranslation(Base.GetTranslation() - ReferenceBone.GetTranslation());
+				Additive.SetScale3D(Base.GetScale3D() * FTransform::GetSafeScaleReciprocal(ReferenceBone.GetScale3D()));
+				FTransform::BlendFromIdentityAndAccumulate(Result, Additive, ScalarRegister(BodyPartWeights.AdditiveLS));
+			}
+
+			if (bNeedsMeshSpace && BodyPartWeights.AdditiveMS > 0.0f)
+			{
+				// As FAnimationRuntime::AccumulateMeshSpaceRotationAdditiveToLocalPose does, the additive rotates the
+				// overlay without the additives of its parents, then the result goes to the space of the parent result
+				const FQuat AdditiveCS = FQuat::FastLerp(FQuat::Identity,
+				                                         BaseRotationsCS[Index] * ReferenceRotationsCS[Index].Inverse(),
+				                                         BodyPartWeights.AdditiveMS).GetNormalized();
+				const FQuat ResultRotationCS = AdditiveCS * ParentOverlayRotationCS * Result.GetRotation();
+				Result.SetRotation((ParentResultRotationCS.Inverse() * ResultRotationCS).GetNormalized());
+			}
+
+			if (BodyPartWeights.Overlay < 1.0f)
+			{
+				Result.BlendWith(Base, 1.0f - BodyPartWeights.Overlay);
+			}
+
+			Pose[BoneIndex] = Result;
+		}
+
+		if (bNeedsMeshSpace)
+		{
+			ResultRotationsCS[Index] = ParentResultRotationCS * Pose[BoneIndex].GetRotation();
+		}
+	}
+}
+
+void FAnimNode_ALSLayering::GatherDebugData(FNodeDebugData& DebugData)
+{
+	FString DebugLine = DebugData.GetNodeName(this);
+	DebugData.AddDebugItem(DebugLine);
+
+	BaseLayer.GatherDebugData(DebugData.BranchFlow(1.0f));
+	OverlayLayer.GatherDebugData(DebugData.BranchFlow(1.0f));
+	BasePose_N.GatherDebugData(DebugData.BranchFlow(1.0f));
+	BasePose_CLF.GatherDebugData(DebugData.BranchFlow(1.0f));
+}
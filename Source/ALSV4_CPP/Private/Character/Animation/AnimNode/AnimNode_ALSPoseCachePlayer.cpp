@@ -0,0 +1,181 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Character/Animation/AnimNode/AnimNode_ALSPoseCachePlayer.h"
+#include "Animation/AnimInstanceProxy.h"
+
+void FAnimNode_ALSPoseCachePlayer::Initialize_AnyThread(const FAnimationInitializeContext& Context)
+{
+	FAnimNode_Base::Initialize_AnyThread(Context);
+	Source.Initialize(Context);
+
+	Samples.Reset();
+	Phase = 0.0f;
+}
+
+void FAnimNode_ALSPoseCachePlayer::CacheBones_AnyThread(const FAnimationCacheBonesContext& Context)
+{
+	Source.CacheBones(Context);
+	CacheCompactBones(Context.AnimInstanceProxy->GetRequiredBones());
+}
+
+void FAnimNode_ALSPoseCachePlayer::CacheCompactBones(const FBoneContainer& RequiredBones)
+{
+	CachedPoseCache = PoseCache;
+	CompactBones.Reset();
+	if (!PoseCache)
+	{
+		return;
+	}
+
+	CompactBones.Reserve(PoseCache->BoneNames.Num());
+	for (const FName& BoneName : PoseCache->BoneNames)
+	{
+		const int32 MeshIndex = RequiredBones.GetPoseBoneIndexForBoneName(BoneName);
+		CompactBones.Add(MeshIndex != INDEX_NONE
+			                 ? RequiredBones.MakeCompactPoseIndex(FMeshPoseBoneIndex(MeshIndex)).GetInt()
+			                 : INDEX_NONE);
+	}
+}
+
+void FAnimNode_ALSPoseCachePlayer::Update_AnyThread(const FAnimationUpdateContext& Context)
+{
+	GetEvaluateGraphExposedInputs().Execute(Context);
+
+	Samples.Reset();
+	if (!bActive || !PoseCache)
+	{
+		Source.Update(Context);
+		return;
+	}
+
+	float PlayRate = 1.0f;
+	PoseCache->FindSamples(Gait, Stance, OverlayState, Speed, Direction, Samples, PlayRate);
+
+	float TotalWeight = 0.0f;
+	float Length = 0.0f;
+	for (const FALSPoseCacheSample& Sample : Samples)
+	{
+		TotalWeight += Sample.Weight;
+		Length += Sample.Weight * PoseCache->Cycles[Sample.Cycle].Length;
+	}
+
+	if (TotalWeight <= KINDA_SMALL_NUMBER)
+	{
+		Samples.Reset();
+		return;
+	}
+
+	for (FALSPoseCacheSample& Sample : Samples)
+	{
+		Sample.Weight /= TotalWeight;
+	}
+
+	// All cycles are sampled at the same phase, so blended cycles of different lengths stay in step
+	Length /= TotalWeight;
+	if (Length > KINDA_SMALL_NUMBER)
+	{
+		Phase = FMath::Fmod(Phase + Context.GetDeltaTime() * PlayRate / Length, 1.0f);
+	}
+}
+
+void FAnimNode_ALSPoseCachePlayer::Evaluate_AnyThread(FPoseContext& Output)
+{
+	if (!bActive || !PoseCache)
+	{
+		Source.Evaluate(Output);
+		return;
+	}
+
+	Output.ResetToRefPose();
+	if (Samples.Num() == 0)
+	{
+		return;
+	}
+
+	if (CachedPoseCache != PoseCache)
+	{
+		CacheCompactBones(Output.AnimInstanceProxy->GetRequiredBones());
+	}
+
+	struct FFrames
+	{
+		const FALSPoseCacheCycle* Cycle;
+		int32 Frame0;
+		int32 Frame1;
+		float Alpha;
+		float Weight;
+	};
+
+	TArray<FFrames, TInlineAllocator<4>> Frames;
+	for (const FALSPoseCacheSample& Sample : Samples)
+	{
+		const FALSPoseCacheCycle& Cycle = PoseCache->Cycles[Sample.Cycle];
+		if (Cycle.NumFrames > 0)
+		{
+			const float Time = Phase * Cycle.NumFrames;
+			const int32 Frame0 = FMath::Min(FMath::FloorToInt(Time), Cycle.NumFrames - 1);
+			Frames.Add({&Cycle, Frame0, (Frame0 + 1) % Cycle.NumFrames, Time - Frame0, Sample.Weight});
+		}
+	}
+
+	FCompactPose& Pose = Output.Pose;
+	for (int32 Bone = 0; Bone < CompactBones.Num(); ++Bone)
+	{
+		if (CompactBones[Bone] == INDEX_NONE)
+		{
+			continue;
+		}
+
+		FQuat Rotation(0.0f, 0.0f, 0.0f, 0.0f);
+		for (const FFrames& Frame : Frames)
+		{
+			FQuat FrameRotation = FQuat::FastLerp(PoseCache->GetRotation(*Frame.Cycle, Frame.Frame0, Bone),
+			                                      PoseCache->GetRotation(*Frame.Cycle, Frame.Frame1, Bone),
+			                                      Frame.Alpha);
+			if ((Rotation | FrameRotation) < 0.0f)
+			{
+				FrameRotation = -FrameRotation;
+			}
+			Rotation += FrameRotation * Frame.Weight;
+		}
+
+		Pose[FCompactPoseBoneIndex(CompactBones[Bone])].SetRotation(Rotation.GetNormalized());
+	}
+
+	// Bones without a track keep the translation of the reference pose
+	for (int32 Track = 0; Track < PoseCache->TranslationTracks.Num(); ++Track)
+	{
+		const int32 CompactIndex = CompactBones[PoseCache->TranslationTracks[Track]];
+		if (CompactIndex == INDEX_NONE)
+		{
+			continue;
+		}
+
+		FVector Translation = FVector::ZeroVector;
+		for (const FFrames& Frame : Frames)
+		{
+			Translation += Frame.Weight * FMath::Lerp(PoseCache->GetTranslation(*Frame.Cycle, Frame.Frame0, Track),
+			                                          PoseCache->GetTranslation(*Frame.Cycle, Frame.Frame1, Track),
+			                                          Frame.Alpha);
+		}
+
+		Pose[FCompactPoseBoneIndex(CompactIndex)].SetTranslation(Translation);
+	}
+}
+
+void FAnimNode_ALSPoseCachePlayer::GatherDebugData(FNodeDebugData& DebugData)
+{
+	FString DebugLine = DebugData.GetNodeName(this);
+	DebugLine += FString::Printf(TEXT("(Active: %d, Samples: %d, Phase: %.2f)"), bActive, Samples.Num(), Phase);
+	DebugData.AddDebugItem(DebugLine, true);
+	if (!bActive || !PoseCache)
+	{
+		Source.GatherDebugData(DebugData);
+	}
+}
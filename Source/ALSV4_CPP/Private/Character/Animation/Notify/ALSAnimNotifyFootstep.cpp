@@ -8,6 +8,7 @@
 
 #include "Character/Animation/Notify/ALSAnimNotifyFootstep.h"
 
+#include "Character/Animation/ALSCharacterAnimInstance.h"
 #include "Components/AudioComponent.h"
 #include "Engine/DataTable.h"
 #include "Library/ALSCharacterStructLibrary.h"
@@ -28,8 +29,20 @@ void UALSAnimNotifyFootstep::Notify(USkeletalMeshComponent* MeshComp, UAnimSeque
 		UWorld* World = MeshComp->GetWorld();
 		AActor* MeshOwner = MeshComp->GetOwner();
 
-		const FVector FootLocation = MeshComp->GetSocketLocation(FootSocketName);
-		const FRotator FootRotation = MeshComp->GetSocketRotation(FootSocketName);
+		UALSCharacterAnimInstance* ALSAnimInstance = Cast<UALSCharacterAnimInstance>(MeshComp->GetAnimInstance());
+		FTransform FootTransform;
+		if (ALSAnimInstance)
+		{
+			FALSBoneCache& BoneCache = ALSAnimInstance->GetBoneCache();
+			FootTransform = BoneCache.GetSocketTransform(*MeshComp, BoneCache.FindOrAddSocket(*MeshComp, FootSocketName));
+		}
+		else
+		{
+			FootTransform = MeshComp->GetSocketTransform(FootSocketName);
+		}
+
+		const FVector FootLocation = FootTransform.GetLocation();
+		const FRotator FootRotation = FootTransform.Rotator();
 		const FVector TraceEnd = FootLocation - MeshOwner->GetActorUpVector() * TraceLength;
 
 		FHitResult Hit;
@@ -73,8 +86,10 @@ void UALSAnimNotifyFootstep::Notify(USkeletalMeshComponent* MeshComp, UAnimSeque
 			{
 				UAudioComponent* SpawnedSound = nullptr;
 
-				const float MaskCurveValue = MeshComp->GetAnimInstance()->GetCurveValue(
-					FName(TEXT("Mask_FootstepSound")));
+				const float MaskCurveValue = ALSAnimInstance
+					                             ? ALSAnimInstance->GetCachedCurveValue(EALSAnimCurve::Mask_FootstepSound)
+					                             : MeshComp->GetAnimInstance()->GetCurveValue(
+						                             FName(TEXT("Mask_FootstepSound")));
 				const float FinalVolMult = bOverrideMaskCurve
 					                           ? VolumeMultiplier
 					                           : VolumeMultiplier * (1.0f - MaskCurveValue);
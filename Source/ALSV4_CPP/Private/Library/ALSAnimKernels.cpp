@@ -0,0 +1,206 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Library/ALSAnimKernels.h"
+
+#include "Async/ParallelFor.h"
+
+void FALSAnimKernelBatch::SetNum(int32 InNumCharacters)
+{
+	NumCharacters = InNumCharacters;
+	Stride = Align(InNumCharacters, 4);
+
+	// Padding lanes stay zero, the kernels mask every division they could turn into a NaN
+	Data.Reset();
+	Data.SetNumZeroed(Stride * NumStreams);
+}
+
+void FALSAnimKernelBatch::SetInput(int32 Index, const FALSAnimKernelInput& Input)
+{
+	check(Index >= 0 && Index < NumCharacters);
+	Stream(VelocityX)[Index] = Input.Velocity.X;
+	Stream(VelocityY)[Index] = Input.Velocity.Y;
+	Stream(VelocityZ)[Index] = Input.Velocity.Z;
+	Stream(AccelerationX)[Index] = Input.Acceleration.X;
+	Stream(AccelerationY)[Index] = Input.Acceleration.Y;
+	Stream(AccelerationZ)[Index] = Input.Acceleration.Z;
+	Stream(Yaw)[Index] = Input.Yaw;
+	Stream(Speed)[Index] = Input.Speed;
+	Stream(GaitCurve)[Index] = Input.GaitCurve;
+	Stream(InvMeshScaleZ)[Index] = 1.0f / Input.MeshScaleZ;
+	Stream(MaxAcceleration)[Index] = Input.MaxAcceleration;
+	Stream(MaxBrakingDeceleration)[Index] = Input.MaxBrakingDeceleration;
+	Stream(InvAnimatedWalkSpeed)[Index] = 1.0f / Input.AnimatedWalkSpeed;
+	Stream(InvAnimatedRunSpeed)[Index] = 1.0f / Input.AnimatedRunSpeed;
+	Stream(InvAnimatedSprintSpeed)[Index] = 1.0f / Input.AnimatedSprintSpeed;
+	Stream(InvAnimatedCrouchSpeed)[Index] = 1.0f / Input.AnimatedCrouchSpeed;
+}
+
+void FALSAnimKernelBatch::GetOutput(int32 Index, FALSAnimKernelOutput& Output) const
+{
+	check(Index >= 0 && Index < NumCharacters);
+	Output.VelocityBlend.F = Stream(VelocityBlendF)[Index];
+	Output.VelocityBlend.B = Stream(VelocityBlendB)[Index];
+	Output.VelocityBlend.L = Stream(VelocityBlendL)[Index];
+	Output.VelocityBlend.R = Stream(VelocityBlendR)[Index];
+	Output.RelativeAcceleration.X = Stream(RelativeAccelerationX)[Index];
+	Output.RelativeAcceleration.Y = Stream(RelativeAccelerationY)[Index];
+	Output.RelativeAcceleration.Z = Stream(RelativeAccelerationZ)[Index];
+	Output.StandingSpeedRate = Stream(StandingSpeedRate)[Index];
+	Output.CrouchingSpeedRate = Stream(CrouchingSpeedRate)[Index];
+	Output.AirLean.LR = Stream(AirLeanLR)[Index];
+	Output.AirLean.FB = Stream(AirLeanFB)[Index];
+}
+
+void FALSAnimKernelBatch::Run(bool bParallel)
+{
+	static constexpr int32 GroupsPerTask = 64;
+	const int32 NumGroups = Stride / 4;
+	const int32 NumTasks = FMath::DivideAndRoundUp(NumGroups, GroupsPerTask);
+	ParallelFor(NumTasks, [this, NumGroups](int32 Task)
+	{
+		const int32 FirstGroup = Task * GroupsPerTask;
+		RunGroups(FirstGroup, FMath::Min(GroupsPerTask, NumGroups - FirstGroup));
+	}, !bParallel || NumTasks < 2);
+}
+
+void FALSAnimKernelBatch::RunGroups(int32 FirstGroup, int32 NumGroups)
+{
+	const VectorRegister Zero = VectorZero();
+	const VectorRegister One = VectorOne();
+	const VectorRegister Two = VectorSetFloat1(2.0f);
+	const VectorRegister DegToRad = VectorSetFloat1(PI / 180.0f);
+	const VectorRegister SafeNormalTolerance = VectorSetFloat1(0.1f);
+	const VectorRegister MinMaxSize = VectorSetFloat1(KINDA_SMALL_NUMBER);
+	const VectorRegister MinSizeSquared = VectorSetFloat1(SMALL_NUMBER);
+	const VectorRegister InvAirLeanSpeed = VectorSetFloat1(1.0f / 350.0f);
+
+	for (int32 Group = FirstGroup; Group < FirstGroup + NumGroups; ++Group)
+	{
+		const int32 Offset = Group * 4;
+		auto Load = [this, Offset](EStream Id) { return VectorLoadAligned(Stream(Id) + Offset); };
+		auto Store = [this, Offset](EStream Id, const VectorRegister& Value)
+		{
+			VectorStoreAligned(Value, Stream(Id) + Offset);
+		};
+
+		// Unrotating by a yaw only rotation is a 2D rotation by -Yaw
+		const VectorRegister YawRadians = VectorMultiply(Load(Yaw), DegToRad);
+		VectorRegister Sin;
+		VectorRegister Cos;
+		VectorSinCos(&Sin, &Cos, &YawRadians);
+
+		const VectorRegister VX = Load(VelocityX);
+		const VectorRegister VY = Load(VelocityY);
+		const VectorRegister VZ = Load(VelocityZ);
+		const VectorRegister RelativeVX = VectorMultiplyAdd(VX, Cos, VectorMultiply(VY, Sin));
+		const VectorRegister RelativeVY = VectorSubtract(VectorMultiply(VY, Cos), VectorMultiply(VX, Sin));
+
+		// Velocity blend. Dividing the relative velocity by the sum of its absolute components gives the same
+		// direction as normalizing it first, only velocities GetSafeNormal treats as zero have to be masked.
+		const VectorRegister VelocitySizeSquared =
+			VectorMultiplyAdd(VX, VX, VectorMultiplyAdd(VY, VY, VectorMultiply(VZ, VZ)));
+		const VectorRegister Sum = VectorAdd(VectorAbs(RelativeVX), VectorAdd(VectorAbs(RelativeVY), VectorAbs(VZ)));
+		const VectorRegister InvSum = VectorSelect(VectorCompareGE(VelocitySizeSquared, SafeNormalTolerance),
+		                                           VectorReciprocalAccurate(Sum), Zero);
+		const VectorRegister DirX = VectorMultiply(RelativeVX, InvSum);
+		const VectorRegister DirY = VectorMultiply(RelativeVY, InvSum);
+		Store(VelocityBlendF, VectorMax(DirX, Zero));
+		Store(VelocityBlendB, VectorMax(VectorNegate(DirX), Zero));
+		Store(VelocityBlendL, VectorMax(VectorNegate(DirY), Zero));
+		Store(VelocityBlendR, VectorMax(DirY, Zero));
+
+		// Relative acceleration. Clamping to the limit and dividing by it scales by 1 / Max(Size, Limit),
+		// limits GetClampedToMaxSize treats as zero give zero.
+		const VectorRegister AX = Load(AccelerationX);
+		const VectorRegister AY = Load(AccelerationY);
+		const VectorRegister AZ = Load(AccelerationZ);
+		const VectorRegister Dot = VectorMultiplyAdd(AX, VX, VectorMultiplyAdd(AY, VY, VectorMultiply(AZ, VZ)));
+		const VectorRegister Limit = VectorSelect(VectorCompareGT(Dot, Zero), Load(MaxAcceleration),
+		                                          Load(MaxBrakingDeceleration));
+		const VectorRegister AccelerationSizeSquared =
+			VectorMax(VectorMultiplyAdd(AX, AX, VectorMultiplyAdd(AY, AY, VectorMultiply(AZ, AZ))), MinSizeSquared);
+		const VectorRegister AccelerationScale = VectorSelect(
+			VectorCompareGE(Limit, MinMaxSize),
+			VectorMin(VectorReciprocalSqrtAccurate(AccelerationSizeSquared), VectorReciprocalAccurate(Limit)), Zero);
+		const VectorRegister ScaledAX = VectorMultiply(AX, AccelerationScale);
+		const VectorRegister ScaledAY = VectorMultiply(AY, AccelerationScale);
+		Store(RelativeAccelerationX, VectorMultiplyAdd(ScaledAX, Cos, VectorMultiply(ScaledAY, Sin)));
+		Store(RelativeAccelerationY, VectorSubtract(VectorMultiply(ScaledAY, Cos), VectorMultiply(ScaledAX, Sin)));
+		Store(RelativeAccelerationZ, VectorMultiply(AZ, AccelerationScale));
+
+		// Speed relative to the animated speed of each gait, blended by the W_Gait curve
+		const VectorRegister CharacterSpeed = Load(Speed);
+		const VectorRegister Gait = Load(GaitCurve);
+		const VectorRegister RunWeight = VectorMin(VectorMax(VectorSubtract(Gait, One), Zero), One);
+		const VectorRegister SprintWeight = VectorMin(VectorMax(VectorSubtract(Gait, Two), Zero), One);
+		const VectorRegister WalkRate = VectorMultiply(CharacterSpeed, Load(InvAnimatedWalkSpeed));
+		const VectorRegister RunRate = VectorMultiply(CharacterSpeed, Load(InvAnimatedRunSpeed));
+		const VectorRegister SprintRate = VectorMultiply(CharacterSpeed, Load(InvAnimatedSprintSpeed));
+		const VectorRegister LerpedRate = VectorMultiplyAdd(VectorSubtract(RunRate, WalkRate), RunWeight, WalkRate);
+		const VectorRegister SprintAffectedRate =
+			VectorMultiplyAdd(VectorSubtract(SprintRate, LerpedRate), SprintWeight, LerpedRate);
+		const VectorRegister InvScale = Load(InvMeshScaleZ);
+		Store(StandingSpeedRate, VectorMultiply(SprintAffectedRate, InvScale));
+		Store(CrouchingSpeedRate,
+		      VectorMultiply(VectorMultiply(CharacterSpeed, Load(InvAnimatedCrouchSpeed)), InvScale));
+
+		Store(AirLeanLR, VectorMultiply(RelativeVY, InvAirLeanSpeed));
+		Store(AirLeanFB, VectorMultiply(RelativeVX, InvAirLeanSpeed));
+	}
+}
+
+void ALSAnimKernels::Compute(const FALSAnimKernelInput& Input, FALSAnimKernelOutput& Output)
+{
+	const FRotator Rotation(0.0f, Input.Yaw, 0.0f);
+
+	const FVector RelativeVelocityDir = Rotation.UnrotateVector(Input.Velocity.GetSafeNormal(0.1f));
+	const float Sum = FMath::Abs(RelativeVelocityDir.X) + FMath::Abs(RelativeVelocityDir.Y) +
+		FMath::Abs(RelativeVelocityDir.Z);
+	const FVector RelativeDir = Sum > 0.0f ? RelativeVelocityDir / Sum : FVector::ZeroVector;
+	Output.VelocityBlend.F = FMath::Clamp(RelativeDir.X, 0.0f, 1.0f);
+	Output.VelocityBlend.B = FMath::Abs(FMath::Clamp(RelativeDir.X, -1.0f, 0.0f));
+	Output.VelocityBlend.L = FMath::Abs(FMath::Clamp(RelativeDir.Y, -1.0f, 0.0f));
+	Output.VelocityBlend.R = FMath::Clamp(RelativeDir.Y, 0.0f, 1.0f);
+
+	const float Limit = FVector::DotProduct(Input.Acceleration, Input.Velocity) > 0.0f
+		                    ? Input.MaxAcceleration
+		                    : Input.MaxBrakingDeceleration;
+	Output.RelativeAcceleration = Limit >= KINDA_SMALL_NUMBER
+		                              ? Rotation.UnrotateVector(Input.Acceleration.GetClampedToMaxSize(Limit) / Limit)
+		                              : FVector::ZeroVector;
+
+	const float LerpedSpeed = FMath::Lerp(Input.Speed / Input.AnimatedWalkSpeed, Input.Speed / Input.AnimatedRunSpeed,
+	                                      FMath::Clamp(Input.GaitCurve - 1.0f, 0.0f, 1.0f));
+	const float SprintAffectedSpeed = FMath::Lerp(LerpedSpeed, Input.Speed / Input.AnimatedSprintSpeed,
+	                                              FMath::Clamp(Input.GaitCurve - 2.0f, 0.0f, 1.0f));
+	Output.StandingSpeedRate = SprintAffectedSpeed / Input.MeshScaleZ;
+	Output.CrouchingSpeedRate = Input.Speed / Input.AnimatedCrouchSpeed / Input.MeshScaleZ;
+
+	const FVector UnrotatedVel = Rotation.UnrotateVector(Input.Velocity) / 350.0f;
+	Output.AirLean.LR = UnrotatedVel.Y;
+	Output.AirLean.FB = UnrotatedVel.X;
+}
+
+float ALSAnimKernels::MaxError(const FALSAnimKernelOutput& A, const FALSAnimKernelOutput& B)
+{
+	const float Errors[] = {
+		FMath::Abs(A.VelocityBlend.F - B.VelocityBlend.F), FMath::Abs(A.VelocityBlend.B - B.VelocityBlend.B),
+		FMath::Abs(A.VelocityBlend.L - B.VelocityBlend.L), FMath::Abs(A.VelocityBlend.R - B.VelocityBlend.R),
+		(A.RelativeAcceleration - B.RelativeAcceleration).GetAbsMax(),
+		FMath::Abs(A.StandingSpeedRate - B.StandingSpeedRate),
+		FMath::Abs(A.CrouchingSpeedRate - B.CrouchingSpeedRate),
+		FMath::Abs(A.AirLean.LR - B.AirLean.LR), FMath::Abs(A.AirLean.FB - B.AirLean.FB)
+	};
+	float Error = 0.0f;
+	for (const float Value : Errors)
+	{
+		Error = FMath::Max(Error, Value);
+	}
+	return Error;
+}
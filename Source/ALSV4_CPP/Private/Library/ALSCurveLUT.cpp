@@ -0,0 +1,212 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Library/ALSCurveLUT.h"
+
+#include "ALSV4_CPP.h"
+#include "Curves/CurveFloat.h"
+#include "Curves/CurveVector.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace ALSCurveLUT
+{
+	TAutoConsoleVariable<int32> CVarEnable(
+		TEXT("als.CurveLUT.Enable"),
+		UE_BUILD_SHIPPING ? 1 : 0,
+		TEXT("Evaluate ALS curve assets through baked lookup tables. Takes effect when the curves are bound again."),
+		ECVF_Default);
+
+	TAutoConsoleVariable<int32> CVarResolution(
+		TEXT("als.CurveLUT.Resolution"),
+		FALSCurveLUT::DefaultResolution,
+		TEXT("Number of segments a curve is sampled into."),
+		ECVF_Default);
+
+	TAutoConsoleVariable<float> CVarMaxError(
+		TEXT("als.CurveLUT.MaxError"),
+		FALSCurveLUT::DefaultMaxError,
+		TEXT("Largest accepted difference of a lookup table to its curve. Curves above it are reported."),
+		ECVF_Default);
+
+	/** Number of points measured between two samples while baking */
+	constexpr int32 ErrorSamplesPerSegment = 4;
+
+	using FKey = TPair<TWeakObjectPtr<const UCurveBase>, int32>;
+
+	FCriticalSection SharedLock;
+
+	TMap<FKey, TSharedPtr<const FALSCurveLUT>>& GetShared()
+	{
+		static TMap<FKey, TSharedPtr<const FALSCurveLUT>> Shared;
+		return Shared;
+	}
+
+#if WITH_EDITOR
+	void OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event)
+	{
+		if (Cast<UCurveBase>(Object))
+		{
+			// Edited curves are baked again on next bind
+			FScopeLock Lock(&SharedLock);
+			for (auto It = GetShared().CreateIterator(); It; ++It)
+			{
+				if (It.Key().Key.Get() == Object)
+				{
+					It.RemoveCurrent();
+				}
+			}
+		}
+	}
+#endif
+}
+
+bool FALSCurveLUT::Bake(const FRichCurve& Curve, int32 Resolution)
+{
+	if (Curve.PreInfinityExtrap != RCCE_Constant || Curve.PostInfinityExtrap != RCCE_Constant)
+	{
+		return false;
+	}
+
+	// A step between two samples would be lerped over the whole segment
+	const TArray<FRichCurveKey>& Keys = Curve.GetConstRefOfKeys();
+	for (int32 Index = 0; Index + 1 < Keys.Num(); ++Index)
+	{
+		if (Keys[Index].InterpMode == RCIM_Constant && Keys[Index].Value != Keys[Index + 1].Value)
+		{
+			return false;
+		}
+	}
+
+	Resolution = FMath::Max(Resolution, 1);
+	Curve.GetTimeRange(MinTime, MaxTime);
+	LastSegment = Resolution - 1;
+
+	const float Step = (MaxTime - MinTime) / Resolution;
+	InvStep = Step > KINDA_SMALL_NUMBER ? 1.0f / Step : 0.0f;
+
+	Samples.SetNumUninitialized(Resolution + 1);
+	for (int32 Index = 0; Index <= Resolution; ++Index)
+	{
+		Samples[Index] = Curve.Eval(MinTime + Step * Index);
+	}
+
+	MaxError = 0.0f;
+	for (int32 Index = 0; Index < Resolution; ++Index)
+	{
+		for (int32 SubIndex = 1; SubIndex < ALSCurveLUT::ErrorSamplesPerSegment; ++SubIndex)
+		{
+			const float Time = MinTime + Step * (Index + static_cast<float>(SubIndex) /
+				ALSCurveLUT::ErrorSamplesPerSegment);
+			MaxError = FMath::Max(MaxError, FMath::Abs(Eval(Time) - Curve.Eval(Time)));
+		}
+	}
+
+	return true;
+}
+
+TSharedPtr<const FALSCurveLUT> FALSCurveLUT::FindOrBake(const UCurveBase* Curve, const FRichCurve& RichCurve,
+                                                        int32 Channel)
+{
+	if (!Curve || !IsEnabled())
+	{
+		return nullptr;
+	}
+
+	FScopeLock Lock(&ALSCurveLUT::SharedLock);
+
+#if WITH_EDITOR
+	static const FDelegateHandle PropertyChangedHandle =
+		FCoreUObjectDelegates::OnObjectPropertyChanged.AddStatic(&ALSCurveLUT::OnObjectPropertyChanged);
+#endif
+
+	const ALSCurveLUT::FKey Key(Curve, Channel);
+	if (const TSharedPtr<const FALSCurveLUT>* Found = ALSCurveLUT::GetShared().Find(Key))
+	{
+		return *Found;
+	}
+
+	TSharedPtr<FALSCurveLUT> LUT = MakeShared<FALSCurveLUT>();
+	if (!LUT->Bake(RichCurve, ALSCurveLUT::CVarResolution.GetValueOnAnyThread()))
+	{
+		LUT.Reset();
+	}
+#if !UE_BUILD_SHIPPING
+	else if (LUT->GetMaxError() > ALSCurveLUT::CVarMaxError.GetValueOnAnyThread())
+	{
+		UE_LOG(LogALS, Warning, TEXT("Curve LUT of %s (channel %d) has error %f, above als.CurveLUT.MaxError"),
+		       *Curve->GetPathName(), Channel, LUT->GetMaxError());
+	}
+#endif
+
+	ALSCurveLUT::GetShared().Add(Key, LUT);
+	return LUT;
+}
+
+void FALSCurveLUT::ResetShared()
+{
+	FScopeLock Lock(&ALSCurveLUT::SharedLock);
+	ALSCurveLUT::GetShared().Reset();
+}
+
+bool FALSCurveLUT::IsEnabled()
+{
+	return ALSCurveLUT::CVarEnable.GetValueOnAnyThread() != 0;
+}
+
+void FALSCurveFloatLUT::Bind(const UCurveFloat* InCurve)
+{
+	const bool bEnabled = FALSCurveLUT::IsEnabled();
+	if (Curve == InCurve && bLUTEnabled == bEnabled)
+	{
+		return;
+	}
+
+	Curve = InCurve;
+	bLUTEnabled = bEnabled;
+	LUT = Curve ? FALSCurveLUT::FindOrBake(Curve, Curve->FloatCurve, 0) : nullptr;
+}
+
+float FALSCurveFloatLUT::GetValue(float Time) const
+{
+	return LUT ? LUT->Eval(Time) : Curve->GetFloatValue(Time);
+}
+
+void FALSCurveVectorLUT::Bind(const UCurveVector* InCurve)
+{
+	const bool bEnabled = FALSCurveLUT::IsEnabled();
+	if (Curve == InCurve && bLUTEnabled == bEnabled)
+	{
+		return;
+	}
+
+	Curve = InCurve;
+	bLUTEnabled = bEnabled;
+	for (int32 Channel = 0; Channel < 3; ++Channel)
+	{
+		LUTs[Channel] = Curve ? FALSCurveLUT::FindOrBake(Curve, Curve->FloatCurves[Channel], Channel) : nullptr;
+	}
+
+	// All channels or none, so evaluation doesn't mix both paths
+	if (!LUTs[0] || !LUTs[1] || !LUTs[2])
+	{
+		LUTs[0].Reset();
+		LUTs[1].Reset();
+		LUTs[2].Reset();
+	}
+}
+
+FVector FALSCurveVectorLUT::GetValue(float Time) const
+{
+	if (!LUTs[0])
+	{
+		return Curve->GetVectorValue(Time);
+	}
+	return FVector(LUTs[0]->Eval(Time), LUTs[1]->Eval(Time), LUTs[2]->Eval(Time));
+}
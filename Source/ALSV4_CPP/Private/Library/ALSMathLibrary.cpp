@@ -30,6 +30,44 @@ TPair<float, float> UALSMathLibrary::FixDiagonalGamepadValues(const float X, con
 	return TPair<float, float>(ResultY, ResultX);
 }
 
+float UALSMathLibrary::GetSubsteppedInterpAlpha(const float DeltaTime, const float InterpSpeed, const float MaxStep)
+{
+	if (InterpSpeed <= 0.0f)
+	{
+		// Same as FMath::FInterpTo, no speed means snap to target
+		return 1.0f;
+	}
+
+	if (DeltaTime <= 0.0f)
+	{
+		return 0.0f;
+	}
+
+	// Each step moves a clamped fraction of the remaining distance, so N steps leave (1 - StepAlpha)^N of it
+	const int32 NumSteps = MaxStep > 0.0f ? FMath::Max(1, FMath::CeilToInt(DeltaTime / MaxStep)) : 1;
+	const float StepAlpha = FMath::Clamp(DeltaTime / NumSteps * InterpSpeed, 0.0f, 1.0f);
+	return 1.0f - FMath::Pow(1.0f - StepAlpha, NumSteps);
+}
+
+float UALSMathLibrary::FInterpToSubstepped(const float Current, const float Target, const float DeltaTime,
+                                           const float InterpSpeed, const float MaxStep)
+{
+	return FMath::Lerp(Current, Target, GetSubsteppedInterpAlpha(DeltaTime, InterpSpeed, MaxStep));
+}
+
+FVector UALSMathLibrary::VInterpToSubstepped(const FVector& Current, const FVector& Target, const float DeltaTime,
+                                             const float InterpSpeed, const float MaxStep)
+{
+	return FMath::Lerp(Current, Target, GetSubsteppedInterpAlpha(DeltaTime, InterpSpeed, MaxStep));
+}
+
+FRotator UALSMathLibrary::RInterpToSubstepped(const FRotator& Current, const FRotator& Target,
+                                              const float DeltaTime, const float InterpSpeed, const float MaxStep)
+{
+	const FRotator Delta = (Target - Current).GetNormalized();
+	return (Current + Delta * GetSubsteppedInterpAlpha(DeltaTime, InterpSpeed, MaxStep)).GetNormalized();
+}
+
 FVector UALSMathLibrary::GetCapsuleBaseLocation(const float ZOffset, UCapsuleComponent* Capsule)
 {
 	return Capsule->GetComponentLocation() -
@@ -0,0 +1,129 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Library/ALSCurveLUT.h"
+
+#include "Curves/RichCurve.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ALSCurveLUTTest
+{
+	struct FKeyDesc
+	{
+		float Time;
+		float Value;
+	};
+
+	FRichCurve MakeCurve(std::initializer_list<FKeyDesc> Keys, ERichCurveInterpMode InterpMode,
+	                     ERichCurveTangentMode TangentMode = RCTM_Auto)
+	{
+		FRichCurve Curve;
+		for (const FKeyDesc& Key : Keys)
+		{
+			const FKeyHandle Handle = Curve.AddKey(Key.Time, Key.Value);
+			Curve.SetKeyInterpMode(Handle, InterpMode);
+			Curve.SetKeyTangentMode(Handle, TangentMode);
+		}
+		Curve.AutoSetTangents();
+		return Curve;
+	}
+
+	/** Flat tangents on every key, e.g. ease in and out blends */
+	FRichCurve MakeFlatTangentCurve(std::initializer_list<FKeyDesc> Keys)
+	{
+		FRichCurve Curve = MakeCurve(Keys, RCIM_Cubic, RCTM_User);
+		for (FRichCurveKey& Key : Curve.Keys)
+		{
+			Key.ArriveTangent = 0.0f;
+			Key.LeaveTangent = 0.0f;
+		}
+		return Curve;
+	}
+
+	/** Largest difference to the curve, sampled much finer than the error measured while baking */
+	float GetDenseError(const FALSCurveLUT& LUT, const FRichCurve& Curve)
+	{
+		constexpr int32 NumSamples = 16384;
+		float MinTime, MaxTime;
+		Curve.GetTimeRange(MinTime, MaxTime);
+
+		float Error = 0.0f;
+		for (int32 Index = 0; Index <= NumSamples; ++Index)
+		{
+			const float Time = FMath::Lerp(MinTime, MaxTime, static_cast<float>(Index) / NumSamples);
+			Error = FMath::Max(Error, FMath::Abs(LUT.Eval(Time) - Curve.Eval(Time)));
+		}
+		return Error;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FALSCurveLUTErrorBoundTest, "ALS.CurveLUT.ErrorBound",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FALSCurveLUTErrorBoundTest::RunTest(const FString& Parameters)
+{
+	using namespace ALSCurveLUTTest;
+
+	// Shapes of the curves ALS ships with: speed mapped blends, normalized blends and lean curves
+	const TPair<const TCHAR*, FRichCurve> Curves[] =
+	{
+		{TEXT("Cubic speed blend"), MakeCurve({{0.0f, 0.2f}, {150.0f, 1.0f}, {300.0f, 1.0f}, {600.0f, 0.5f}},
+		                                      RCIM_Cubic)},
+		{TEXT("Cubic peak"), MakeCurve({{0.0f, 0.0f}, {0.5f, 1.0f}, {1.0f, 0.2f}}, RCIM_Cubic)},
+		{TEXT("Cubic lean"), MakeCurve({{-1000.0f, -1.0f}, {0.0f, 0.0f}, {1000.0f, 1.0f}}, RCIM_Cubic)},
+		{TEXT("Flat tangents"), MakeFlatTangentCurve({{0.0f, 0.0f}, {0.3f, 1.0f}, {0.7f, 0.25f}, {1.0f, 1.0f}})},
+		{TEXT("Linear"), MakeCurve({{0.0f, 0.0f}, {0.4f, 1.0f}, {1.0f, 0.0f}}, RCIM_Linear)}
+	};
+
+	for (const TPair<const TCHAR*, FRichCurve>& Entry : Curves)
+	{
+		const FRichCurve& Curve = Entry.Value;
+		FALSCurveLUT LUT;
+		if (!TestTrue(FString::Printf(TEXT("%s is baked"), Entry.Key),
+		              LUT.Bake(Curve, FALSCurveLUT::DefaultResolution)))
+		{
+			continue;
+		}
+
+		TestTrue(FString::Printf(TEXT("%s error %f is below the bound"), Entry.Key, LUT.GetMaxError()),
+		         LUT.GetMaxError() < FALSCurveLUT::DefaultMaxError);
+		TestTrue(FString::Printf(TEXT("%s dense error is below the bound"), Entry.Key),
+		         GetDenseError(LUT, Curve) < FALSCurveLUT::DefaultMaxError);
+
+		// Time is clamped to the key range, as the constant extrapolation of the curve does
+		float MinTime, MaxTime;
+		Curve.GetTimeRange(MinTime, MaxTime);
+		const float Range = MaxTime - MinTime;
+		TestEqual(FString::Printf(TEXT("%s before the first key"), Entry.Key),
+		          LUT.Eval(MinTime - Range), Curve.Eval(MinTime - Range), KINDA_SMALL_NUMBER);
+		TestEqual(FString::Printf(TEXT("%s after the last key"), Entry.Key),
+		          LUT.Eval(MaxTime + Range), Curve.Eval(MaxTime + Range), KINDA_SMALL_NUMBER);
+	}
+
+	// Steps can't be represented by lerped samples, such curves are evaluated directly
+	FALSCurveLUT SteppedLUT;
+	TestFalse(TEXT("Stepped curve is not baked"),
+	          SteppedLUT.Bake(MakeCurve({{0.0f, 0.0f}, {0.33f, 1.0f}, {1.0f, 0.5f}}, RCIM_Constant),
+	                          FALSCurveLUT::DefaultResolution));
+
+	FALSCurveLUT FlatSteppedLUT;
+	TestTrue(TEXT("Constant keys without a step are baked"),
+	         FlatSteppedLUT.Bake(MakeCurve({{0.0f, 1.0f}, {0.5f, 1.0f}}, RCIM_Constant),
+	                             FALSCurveLUT::DefaultResolution));
+
+	FRichCurve CycledCurve = MakeCurve({{0.0f, 0.0f}, {1.0f, 1.0f}}, RCIM_Cubic);
+	CycledCurve.PostInfinityExtrap = RCCE_Cycle;
+	FALSCurveLUT CycledLUT;
+	TestFalse(TEXT("Cycled curve is not baked"), CycledLUT.Bake(CycledCurve, FALSCurveLUT::DefaultResolution));
+
+	return true;
+}
+
+#endif
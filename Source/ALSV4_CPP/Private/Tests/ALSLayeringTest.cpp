@@ -0,0 +1,114 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Character/Animation/AnimNode/AnimNode_ALSLayering.h"
+
+#include "AnimationRuntime.h"
+#include "Animation/AnimationPoseData.h"
+#include "Animation/CustomAttributesRuntime.h"
+#include "Animation/Skeleton.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ALSLayeringTest
+{
+	constexpr int32 NumBones = 3;
+
+	/** Root, spine and head bone in a single chain */
+	USkeleton* MakeChainSkeleton()
+	{
+		USkeleton* Skeleton = NewObject<USkeleton>(GetTransientPackage());
+		FReferenceSkeletonModifier Modifier(Skeleton);
+		const FTransform BonePose(FVector(0.0f, 0.0f, 20.0f));
+		Modifier.Add(FMeshBoneInfo(TEXT("root"), TEXT("root"), INDEX_NONE), FTransform::Identity);
+		Modifier.Add(FMeshBoneInfo(TEXT("spine_01"), TEXT("spine_01"), 0), BonePose);
+		Modifier.Add(FMeshBoneInfo(TEXT("neck_01"), TEXT("neck_01"), 1), BonePose);
+		return Skeleton;
+	}
+
+	/** Same translations on every pose, so only the rotations take part in the additives */
+	void SetRotations(FCompactPose& Pose, std::initializer_list<FRotator> Rotations)
+	{
+		Pose.ResetToRefPose();
+		int32 Index = 0;
+		for (const FRotator& Rotation : Rotations)
+		{
+			Pose[FCompactPoseBoneIndex(Index++)].SetRotation(Rotation.Quaternion());
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FALSLayeringMeshSpaceAdditiveTest, "ALS.Layering.MeshSpaceAdditive",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FALSLayeringMeshSpaceAdditiveTest::RunTest(const FString& Parameters)
+{
+	using namespace ALSLayeringTest;
+
+	USkeleton* Skeleton = MakeChainSkeleton();
+	const TArray<FBoneIndexType> RequiredBones = {0, 1, 2};
+	FBoneContainer BoneContainer(RequiredBones, FCurveEvaluationOption(false), *Skeleton);
+
+	FCompactPose Base;
+	FCompactPose Reference;
+	FCompactPose Overlay;
+	Base.SetBoneContainer(&BoneContainer);
+	Reference.SetBoneContainer(&BoneContainer);
+	Overlay.SetBoneContainer(&BoneContainer);
+	SetRotations(Base, {FRotator(0.0f, 10.0f, 0.0f), FRotator(20.0f, 0.0f, 15.0f), FRotator(-10.0f, 30.0f, 5.0f)});
+	SetRotations(Reference, {FRotator(0.0f, 0.0f, 0.0f), FRotator(5.0f, -10.0f, 0.0f), FRotator(0.0f, 10.0f, -5.0f)});
+	SetRotations(Overlay, {FRotator(0.0f, 40.0f, 0.0f), FRotator(-30.0f, 15.0f, 10.0f), FRotator(25.0f, 0.0f, 20.0f)});
+
+	// Additive of the base layer to its base pose, as the Make Dynamic Additive node builds it in mesh space
+	FCompactPose Additive(Base);
+	FCompactPose ReferenceMS(Reference);
+	FAnimationRuntime::ConvertPoseToMeshRotation(Additive);
+	FAnimationRuntime::ConvertPoseToMeshRotation(ReferenceMS);
+	FAnimationRuntime::ConvertPoseToAdditive(Additive, ReferenceMS);
+
+	// The whole chain is one body part whose overlay is fully weighted, it gets the overlay with the additive
+	const TArray<uint8> BodyParts = {
+		FAnimNode_ALSLayering::BodyPart_Spine, FAnimNode_ALSLayering::BodyPart_Spine,
+		FAnimNode_ALSLayering::BodyPart_Spine
+	};
+
+	for (const float Weight : {1.0f, 0.5f})
+	{
+		FCompactPose Expected(Overlay);
+		FBlendedCurve ExpectedCurve;
+		FBlendedCurve AdditiveCurve;
+		ExpectedCurve.InitFrom(BoneContainer);
+		AdditiveCurve.InitFrom(BoneContainer);
+		FStackCustomAttributes ExpectedAttributes;
+		FStackCustomAttributes AdditiveAttributes;
+		FAnimationPoseData ExpectedData(Expected, ExpectedCurve, ExpectedAttributes);
+		FAnimationPoseData AdditiveData(Additive, AdditiveCurve, AdditiveAttributes);
+		FAnimationRuntime::AccumulateMeshSpaceRotationAdditiveToLocalPose(ExpectedData, AdditiveData, Weight);
+
+		FAnimNode_ALSLayering::FBodyPartWeights Weights[FAnimNode_ALSLayering::BodyPart_Num];
+		Weights[FAnimNode_ALSLayering::BodyPart_Spine].Overlay = 1.0f;
+		Weights[FAnimNode_ALSLayering::BodyPart_Spine].AdditiveMS = Weight;
+
+		FCompactPose Result(Base);
+		FAnimNode_ALSLayering::LayerPoses(Result, Overlay, Reference, Weights, BodyParts);
+
+		for (int32 Index = 0; Index < NumBones; ++Index)
+		{
+			const FCompactPoseBoneIndex BoneIndex(Index);
+			const float AngularDistance = Result[BoneIndex].GetRotation().AngularDistance(
+				Expected[BoneIndex].GetRotation());
+			TestTrue(FString::Printf(TEXT("Bone %d at weight %.1f matches the engine mesh space additive, %f rad off"),
+			                         Index, Weight, AngularDistance), AngularDistance < 1.0e-3f);
+		}
+	}
+
+	return true;
+}
+
+#endif
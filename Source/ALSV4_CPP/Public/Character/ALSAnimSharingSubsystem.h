@@ -0,0 +1,99 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "Library/ALSCharacterEnumLibrary.h"
+
+#include "ALSAnimSharingSubsystem.generated.h"
+
+class AALSBaseCharacter;
+class USkeletalMesh;
+
+/**
+ * Shares poses between low significance ALS characters. Registered characters are bucketed by their movement
+ * state, gait, stance, overlay state, speed band and mesh. One leader per bucket evaluates its anim instance,
+ * the other members copy its pose through the master pose component and keep their own root transform.
+ */
+UCLASS()
+class ALSV4_CPP_API UALSAnimSharingSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+	// End of FTickableGameObject interface
+
+	void RegisterCharacter(AALSBaseCharacter* Character);
+
+	void UnregisterCharacter(AALSBaseCharacter* Character);
+
+	/** True if the pose of given character is copied from another character */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Anim Sharing")
+	bool IsFollower(const AALSBaseCharacter* Character) const;
+
+private:
+	struct FBucketKey
+	{
+		const USkeletalMesh* Mesh = nullptr;
+		EALSMovementState MovementState = EALSMovementState::None;
+		EALSGait Gait = EALSGait::Walking;
+		EALSStance Stance = EALSStance::Standing;
+		EALSOverlayState OverlayState = EALSOverlayState::Default;
+		int32 SpeedBand = 0;
+
+		bool operator==(const FBucketKey& Other) const
+		{
+			return Mesh == Other.Mesh && MovementState == Other.MovementState && Gait == Other.Gait &&
+				Stance == Other.Stance && OverlayState == Other.OverlayState && SpeedBand == Other.SpeedBand;
+		}
+
+		friend uint32 GetTypeHash(const FBucketKey& Key)
+		{
+			const uint32 States = static_cast<uint32>(Key.MovementState) | static_cast<uint32>(Key.Gait) << 8 |
+				static_cast<uint32>(Key.Stance) << 16 | static_cast<uint32>(Key.OverlayState) << 24;
+			return HashCombine(HashCombine(PointerHash(Key.Mesh), States), GetTypeHash(Key.SpeedBand));
+		}
+	};
+
+	struct FSharedCharacter
+	{
+		TWeakObjectPtr<AALSBaseCharacter> Character;
+
+		/** Character this one copies its pose from, null if it animates itself */
+		TWeakObjectPtr<AALSBaseCharacter> Leader;
+
+		float Significance = 1.0f;
+
+		bool bIsLeader = false;
+
+		/** Mesh was taken from the animation budget allocator while following */
+		bool bLeftBudgetAllocator = false;
+	};
+
+	static FBucketKey MakeBucketKey(const AALSBaseCharacter& Character);
+
+	void UpdateSharing();
+
+	void Follow(FSharedCharacter& Entry, AALSBaseCharacter* Leader);
+
+	void StopFollowing(FSharedCharacter& Entry);
+
+	TArray<FSharedCharacter> Characters;
+
+	float TimeUntilUpdate = 0.0f;
+};
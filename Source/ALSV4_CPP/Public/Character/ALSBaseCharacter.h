@@ -10,8 +10,12 @@
 
 #include "CoreMinimal.h"
 #include "Components/TimelineComponent.h"
+#include "Library/ALSAnimationStructLibrary.h"
 #include "Library/ALSCharacterEnumLibrary.h"
 #include "Library/ALSCharacterStructLibrary.h"
+#include "Character/ALSBoneCache.h"
+#include "Character/ALSDeadlineSubsystem.h"
+#include "Library/ALSDoubleBuffer.h"
 #include "Engine/DataTable.h"
 #include "GameFramework/Character.h"
 
@@ -24,6 +28,53 @@ class UALSCharacterAnimInstance;
 class UALSPlayerCameraBehavior;
 enum class EVisibilityBasedAnimTickOption : uint8;
 
+/** Cached state the essential values are derived from, gathered on game thread */
+struct FALSEssentialValuesInput
+{
+	FVector Velocity = FVector::ZeroVector;
+
+	FVector PreviousVelocity = FVector::ZeroVector;
+
+	/** Current acceleration of the movement component, replicated to simulated proxies */
+	FVector CurrentAcceleration = FVector::ZeroVector;
+
+	FRotator AimingRotation = FRotator::ZeroRotator;
+
+	FRotator ControlRotation = FRotator::ZeroRotator;
+
+	FRotator LastVelocityRotation = FRotator::ZeroRotator;
+
+	FRotator LastMovementInputRotation = FRotator::ZeroRotator;
+
+	float DeltaTime = 0.0f;
+
+	float EasedMaxAcceleration = 0.0f;
+
+	float PreviousAimYaw = 0.0f;
+};
+
+struct FALSEssentialValuesOutput
+{
+	/** Velocity change over the frame, filtered by SetAcceleration when applied */
+	FVector Acceleration = FVector::ZeroVector;
+
+	FRotator AimingRotation = FRotator::ZeroRotator;
+
+	FRotator LastVelocityRotation = FRotator::ZeroRotator;
+
+	FRotator LastMovementInputRotation = FRotator::ZeroRotator;
+
+	float Speed = 0.0f;
+
+	float MovementInputAmount = 0.0f;
+
+	float AimYawRate = 0.0f;
+
+	bool bIsMoving = false;
+
+	bool bHasMovementInput = false;
+};
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FJumpPressedSignature);
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FRagdollStateChangedSignature, bool, bRagdollState);
@@ -32,7 +83,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FRagdollStateChangedSignature, bool,
  * Base character class
  */
 UCLASS(BlueprintType)
-class ALSV4_CPP_API AALSBaseCharacter : public ACharacter
+class ALSV4_CPP_API AALSBaseCharacter : public ACharacter, public IALSDeadlineReceiver
 {
 	GENERATED_BODY()
 
@@ -49,6 +100,12 @@ public:
 
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// IALSDeadlineReceiver interface
+	virtual void OnDeadline(FALSDeadline& Deadline) override;
+	// End of IALSDeadlineReceiver interface
+
 	virtual void PreInitializeComponents() override;
 
 	virtual void SetupPlayerInputComponent(UInputComponent* PlayerInputComponent) override;
@@ -254,9 +311,53 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "ALS|Utility")
 	UALSCharacterAnimInstance* GetMainAnimInstance() { return MainAnimInstance; }
 
+	/** Value of any curve of the main anim instance, looked up by name. Prefer GetGameplayCurves where possible. */
 	UFUNCTION(BlueprintCallable, Category = "ALS|Utility")
 	float GetAnimCurveValue(FName CurveName) const;
 
+	/** Curves the character rotation is driven by, published by the last evaluation of the main anim instance */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Utility")
+	FALSGameplayCurves GetGameplayCurves() const;
+
+	/** Bone and socket indices of the character mesh, rebuilt when the skeletal mesh changes */
+	const FALSBoneCache& GetBoneCache() const;
+
+	/** Significance */
+
+	/** 1 for characters which must animate at full quality, 0 for characters nobody sees */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Significance")
+	virtual float GetAnimSignificance() const;
+
+	/**
+	 * Make given tick function wait for the character update, which runs in the actor tick or in the batch of
+	 * UALSTickSubsystem. Call after BeginPlay, the character joins the batch there.
+	 */
+	void AddUpdatePrerequisite(FTickFunction& Dependent);
+
+	void RemoveUpdatePrerequisite(FTickFunction& Dependent);
+
+	/** Whether the mesh is animated in server anim mode, see bUseServerAnimMode */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Significance")
+	bool IsServerAnimMode() const;
+
+	/**
+	 * Significance of the character seen from a single viewpoint, selects its tick bucket. 1 for player controlled
+	 * characters. Called from worker threads by the significance manager update.
+	 */
+	virtual float GetTickSignificance(const FTransform& Viewpoint) const;
+
+	/** First tick bucket whose minimum significance given significance reaches, the last one otherwise */
+	int32 FindTickBucket(float Significance) const;
+
+	/** Tick the character and its mantle component at the interval of given bucket */
+	void SetTickBucket(int32 NewTickBucket);
+
+	/** Ragdoll pull and mantle timelines only keep up when ticked every frame, such characters stay in bucket 0 */
+	bool RequiresFullTickRate() const;
+
+	UFUNCTION(BlueprintCallable, Category = "ALS|Significance")
+	int32 GetTickBucket() const { return TickBucket; }
+
 	/** Camera System */
 
 	UFUNCTION(BlueprintGetter, Category = "ALS|Camera System")
@@ -321,7 +422,31 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "ALS|Essential Information")
 	void GetControlForwardRightVector(FVector& Forward, FVector& Right) const;
 
+	/** Capture the state SetEssentialValues derives from. Game thread only. */
+	void GatherEssentialValues(float DeltaTime, FALSEssentialValuesInput& OutInput);
+
+	/** Derive the essential values of one character, touches no UObject. Any thread. */
+	static void ComputeEssentialValues(const FALSEssentialValuesInput& Input, FALSEssentialValuesOutput& OutOutput);
+
+	/** Store computed essential values, the next tick of this frame uses them instead of computing its own */
+	void ApplyEssentialValues(const FALSEssentialValuesOutput& Output);
+
+	/**
+	 * Essential values and states as of the end of the last character tick, read by the anim instance and the
+	 * camera behavior. Lock free from any thread.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Essential Information")
+	FALSCharacterFrameState GetFrameState() const { return FrameState.Read(); }
+
 protected:
+	/** Significance */
+
+	/** Report significance of the mesh to the animation budget allocator */
+	void UpdateAnimationBudget();
+
+	/** Evaluate the pose on the server only while the character reads its curves */
+	void UpdateServerPoseEvaluation();
+
 	/** Ragdoll System */
 
 	void RagdollUpdate(float DeltaTime);
@@ -358,6 +483,12 @@ protected:
 
 	void SetEssentialValues(float DeltaTime);
 
+	/**
+	 * Snapshot the values readers of the frame state need and publish them. Called at the end of each tick and by
+	 * the state setters, so a state change reaches the anim instance on the same frame in any tick bucket.
+	 */
+	void PublishFrameState();
+
 	void UpdateCharacterMovement();
 
 	void UpdateGroundedRotation(float DeltaTime);
@@ -596,12 +727,71 @@ protected:
 	/* Dedicated server mesh default visibility based anim tick option*/
 	EVisibilityBasedAnimTickOption DefVisBasedTickOp;
 
+	/** Significance */
+
+	/** Camera distance at which the significance of a rendered character reaches its lowest value */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|Significance")
+	float SignificanceMaxDistance = 5000.0f;
+
+	/**
+	 * Register the mesh with the animation budget allocator, which throttles mesh ticks to a fixed time budget.
+	 * Significance of the mesh is given by GetAnimSignificance.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|Significance")
+	bool bUseAnimationBudgetAllocator = false;
+
+	/** Let the pose of the mesh be copied from a similar character while the character is not significant */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|Significance")
+	bool bUseAnimSharing = false;
+
+	/** Compute the velocity blend, relative acceleration, play rates and air lean in one batch with other characters */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|Significance")
+	bool bUseBatchedAnimKernels = false;
+
+	/**
+	 * On dedicated servers, only update the anim values behind the YawOffset and RotationAmount curves, skip
+	 * the overlay layer and foot IK, and evaluate the pose only while the character reads these curves.
+	 * Leave disabled if the server needs an up to date pose, e.g. for hit detection against the mesh.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|Significance")
+	bool bUseServerAnimMode = false;
+
+	/**
+	 * Tick the character, its mantle and debug components in one batch with other characters instead of
+	 * through their own tick functions. Tick prerequisites of the character are ignored, its tick interval
+	 * applies to the whole batch entry.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|Significance")
+	bool bUseBatchedTick = false;
+
+	/**
+	 * Let the significance manager assign the character one of the TickBuckets, from its distance to the player
+	 * views and, on servers, its network relevancy. Player controlled characters always use the first bucket.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|Significance")
+	bool bUseSignificanceTickBuckets = false;
+
+	/** Ordered from the highest to the lowest significance */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|Significance",
+		meta = (EditCondition = "bUseSignificanceTickBuckets"))
+	TArray<FALSTickBucket> TickBuckets;
+
+	/** Index in TickBuckets the character currently ticks at */
+	int32 TickBucket = 0;
+
 	/** Cached Variables */
 
+	mutable FALSBoneCache BoneCache;
+
 	FVector PreviousVelocity = FVector::ZeroVector;
 
 	float PreviousAimYaw = 0.0f;
 
+	TALSDoubleBuffer<FALSCharacterFrameState> FrameState;
+
+	/** Frame the essential values were last applied on */
+	uint64 EssentialValuesFrame = 0;
+
 	UPROPERTY(BlueprintReadOnly)
 	UALSCharacterAnimInstance* MainAnimInstance = nullptr;
 
@@ -614,11 +804,11 @@ protected:
 	/** Last time the camera action button is pressed */
 	float CameraActionPressedTime = 0.0f;
 
-	/* Timer to manage camera mode swap action */
-	FTimerHandle OnCameraModeSwapTimer;
+	/* Deadline to manage camera mode swap action */
+	FALSDeadline OnCameraModeSwapDeadline;
 
-	/* Timer to manage reset of braking friction factor after on landed event */
-	FTimerHandle OnLandedFrictionResetTimer;
+	/* Deadline to manage reset of braking friction factor after on landed event */
+	FALSDeadline OnLandedFrictionResetDeadline;
 
 	/* Smooth out aiming by interping control rotation*/
 	FRotator AimingRotation = FRotator::ZeroRotator;
@@ -0,0 +1,115 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+
+class USkeletalMesh;
+class USkeletalMeshComponent;
+class USkeletalMeshSocket;
+class UPhysicsAsset;
+struct FBodyInstance;
+
+/** Bones and sockets ALS queries by name */
+enum class EALSBone : uint8
+{
+	Root,
+	Pelvis,
+	Spine03,
+	Head,
+	IKFoot_L,
+	IKFoot_R,
+	FootTarget_L,
+	FootTarget_R,
+	FPCamera,
+	TPCameraTrace_L,
+	TPCameraTrace_R,
+	MAX
+};
+
+/**
+ * Bone and socket indices of a skeletal mesh component, resolved once per skeletal mesh.
+ * Lookups are plain array accesses instead of searching the sockets and the reference skeleton by name.
+ */
+struct ALSV4_CPP_API FALSBoneCache
+{
+	/** Rebuild the cache if the skeletal mesh or the physics asset of the component changed */
+	void Update(const USkeletalMeshComponent& Component);
+
+	void Reset();
+
+	/** Index of a bone or a socket which isn't listed in EALSBone, valid until the skeletal mesh changes */
+	int32 FindOrAddSocket(const USkeletalMeshComponent& Component, FName SocketName);
+
+	static FName GetBoneName(EALSBone Bone);
+
+	int32 GetBoneIndex(EALSBone Bone) const
+	{
+		return Entries[static_cast<int32>(Bone)].BoneIndex;
+	}
+
+	FTransform GetTransform(const USkeletalMeshComponent& Component, EALSBone Bone,
+	                        ERelativeTransformSpace Space = RTS_World) const
+	{
+		return GetEntryTransform(Component, static_cast<int32>(Bone), Space);
+	}
+
+	FVector GetLocation(const USkeletalMeshComponent& Component, EALSBone Bone,
+	                    ERelativeTransformSpace Space = RTS_World) const
+	{
+		return GetTransform(Component, Bone, Space).GetLocation();
+	}
+
+	FRotator GetRotation(const USkeletalMeshComponent& Component, EALSBone Bone,
+	                     ERelativeTransformSpace Space = RTS_World) const
+	{
+		return GetTransform(Component, Bone, Space).Rotator();
+	}
+
+	FTransform GetSocketTransform(const USkeletalMeshComponent& Component, int32 SocketIndex,
+	                              ERelativeTransformSpace Space = RTS_World) const
+	{
+		return GetEntryTransform(Component, SocketIndex, Space);
+	}
+
+	/** Body of the bone, if the physics state of the component is created */
+	FBodyInstance* GetBodyInstance(const USkeletalMeshComponent& Component, EALSBone Bone) const;
+
+	/**
+	 * World transform of the body of the bone while it simulates physics, of the bone otherwise.
+	 * Unlike the bone, the body is up to date even if the pose is not evaluated.
+	 */
+	FTransform GetSimulatedTransform(const USkeletalMeshComponent& Component, EALSBone Bone) const;
+
+private:
+	struct FEntry
+	{
+		FName Name;
+
+		const USkeletalMeshSocket* Socket = nullptr;
+
+		/** Bone of the socket, or the bone itself */
+		int32 BoneIndex = INDEX_NONE;
+
+		int32 BodyIndex = INDEX_NONE;
+	};
+
+	void ResolveEntry(const USkeletalMeshComponent& Component, FEntry& Entry) const;
+
+	FTransform GetEntryTransform(const USkeletalMeshComponent& Component, int32 EntryIndex,
+	                             ERelativeTransformSpace Space) const;
+
+	/** EALSBone entries first, then the sockets added with FindOrAddSocket */
+	TArray<FEntry, TInlineAllocator<static_cast<int32>(EALSBone::MAX) + 4>> Entries;
+
+	TWeakObjectPtr<const USkeletalMesh> CachedSkeletalMesh;
+
+	TWeakObjectPtr<const UPhysicsAsset> CachedPhysicsAsset;
+};
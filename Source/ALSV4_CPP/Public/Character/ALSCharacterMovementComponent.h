@@ -10,6 +10,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Library/ALSCharacterStructLibrary.h"
+#include "Library/ALSCurveLUT.h"
 
 #include "ALSCharacterMovementComponent.generated.h"
 
@@ -64,6 +65,11 @@ class ALSV4_CPP_API UALSCharacterMovementComponent : public UCharacterMovementCo
 
 	UPROPERTY(BlueprintReadOnly, Category = "ALS|Movement System")
 	FALSMovementSettings CurrentMovementSettings;
+
+	/** Curves of the current movement settings, evaluated through lookup tables when enabled */
+	FALSCurveVectorLUT MovementCurveLUT;
+
+	FALSCurveFloatLUT RotationRateCurveLUT;
 	
 	// Set Movement Curve (Called in every instance)
 	float GetMappedSpeed() const;
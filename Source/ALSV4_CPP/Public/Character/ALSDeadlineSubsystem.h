@@ -0,0 +1,108 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+
+#include "ALSDeadlineSubsystem.generated.h"
+
+/** One shot deadline stored inline in its owner. Scheduling it again replaces the pending one. */
+struct FALSDeadline
+{
+	bool IsActive() const { return bActive; }
+
+	/** Drop the pending deadline, its entry in the wheel is discarded when its bucket is processed */
+	void Cancel()
+	{
+		++Serial;
+		bActive = false;
+	}
+
+private:
+	friend class UALSDeadlineSubsystem;
+
+	uint32 Serial = 0;
+
+	bool bActive = false;
+};
+
+/** Receives the deadlines it scheduled, the owner tells them apart by address */
+class IALSDeadlineReceiver
+{
+public:
+	virtual ~IALSDeadlineReceiver() = default;
+
+	virtual void OnDeadline(FALSDeadline& Deadline) = 0;
+};
+
+/**
+ * Timing wheel of short one shot ALS deadlines, processed in one batch per frame. Unlike world timers no handle
+ * or delegate is allocated per deadline, entries only point back to the deadline inside their owner.
+ */
+UCLASS()
+class ALSV4_CPP_API UALSDeadlineSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+	// End of FTickableGameObject interface
+
+	/**
+	 * Fire given deadline of the receiver after Delay seconds of game time. As with world timers, a delay
+	 * of zero or less only cancels the pending deadline.
+	 */
+	template <typename ReceiverType>
+	static void Schedule(ReceiverType* Receiver, FALSDeadline& Deadline, float Delay)
+	{
+		Schedule(Receiver, Receiver, Deadline, Delay);
+	}
+
+	static void Schedule(UObject* Owner, IALSDeadlineReceiver* Receiver, FALSDeadline& Deadline, float Delay);
+
+private:
+	struct FEntry
+	{
+		TWeakObjectPtr<UObject> Owner;
+
+		IALSDeadlineReceiver* Receiver = nullptr;
+
+		/** Only accessed while the owner is alive */
+		FALSDeadline* Deadline = nullptr;
+
+		float FireTime = 0.0f;
+
+		/** Serial of the deadline when scheduled, the entry is stale once they differ */
+		uint32 Serial = 0;
+	};
+
+	static constexpr int32 NumBuckets = 64;
+
+	static constexpr float BucketDuration = 1.0f / 32.0f;
+
+	void Add(FEntry&& Entry);
+
+	TArray<FEntry> Buckets[NumBuckets];
+
+	/** Entries due in the same frame, fired after all buckets are processed */
+	TArray<FEntry> DueEntries;
+
+	/** Last bucket tick all entries of which were processed */
+	int64 CompletedTick = -1;
+
+	int32 NumEntries = 0;
+};
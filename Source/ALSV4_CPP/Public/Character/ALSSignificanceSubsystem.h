@@ -0,0 +1,68 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+
+#include "ALSSignificanceSubsystem.generated.h"
+
+class AALSBaseCharacter;
+class APlayerController;
+
+/**
+ * Registers ALS characters with the significance manager, which assigns each of them a tick bucket from its
+ * significance. Unless disabled with als.Significance.UpdateManager, the subsystem also updates the significance
+ * manager from the player views, projects updating it themselves keep their own viewpoints.
+ * On servers, characters no player connection considers relevant are moved to their last bucket.
+ */
+UCLASS()
+class ALSV4_CPP_API UALSSignificanceSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	static const FName CharacterTag;
+
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+	// End of FTickableGameObject interface
+
+	void RegisterCharacter(AALSBaseCharacter* Character);
+
+	/** Character returns to its first tick bucket */
+	void UnregisterCharacter(AALSBaseCharacter* Character);
+
+private:
+	struct FViewer
+	{
+		TWeakObjectPtr<APlayerController> Controller;
+
+		FVector Location = FVector::ZeroVector;
+	};
+
+	/** Player views of the last update, relevancy is checked against them */
+	void GatherViewers(TArray<FTransform, TInlineAllocator<4>>& OutViewpoints);
+
+	bool IsNetRelevant(const AALSBaseCharacter& Character) const;
+
+	void OnSignificanceUpdated(AALSBaseCharacter& Character, float Significance, bool bFinal) const;
+
+	TArray<TWeakObjectPtr<AALSBaseCharacter>> Characters;
+
+	TArray<FViewer> Viewers;
+
+	float TimeUntilUpdate = 0.0f;
+};
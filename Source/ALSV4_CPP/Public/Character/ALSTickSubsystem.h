@@ -0,0 +1,104 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Character/ALSBaseCharacter.h"
+
+#include "ALSTickSubsystem.generated.h"
+
+class UActorComponent;
+class UALSTickSubsystem;
+
+/** Ticks all registered characters once their movement ticked, and before their meshes update animation */
+USTRUCT()
+struct FALSCharacterTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	FALSCharacterTickFunction();
+
+	UALSTickSubsystem* Subsystem = nullptr;
+
+	// FTickFunction interface
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread,
+	                         const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+	// End of FTickFunction interface
+};
+
+template <>
+struct TStructOpsTypeTraits<FALSCharacterTickFunction> : public TStructOpsTypeTraitsBase2<FALSCharacterTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+/**
+ * Ticks the registered characters, their mantle and debug components from a single tick function, in the order
+ * they registered. Their own tick functions are unregistered, disabling them still stops the batched tick, and
+ * the tick interval of the character is honored for the whole entry.
+ * Prerequisites of the character tick function are not carried over, dependents of the character update use
+ * AALSBaseCharacter::AddUpdatePrerequisite instead.
+ */
+UCLASS()
+class ALSV4_CPP_API UALSTickSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	/** Take over the tick of given character, called once it begun play */
+	void RegisterCharacter(AALSBaseCharacter* Character);
+
+	/** Stop ticking given character, called when it leaves play. Its tick functions are not registered again. */
+	void UnregisterCharacter(AALSBaseCharacter* Character);
+
+	bool IsRegistered(const AALSBaseCharacter* Character) const;
+
+	FTickFunction& GetTickFunction() { return TickFunction; }
+
+	void TickCharacters(float DeltaTime, ELevelTick TickType);
+
+private:
+	/**
+	 * Compute the essential values of all characters about to tick in parallel. Inputs are gathered and results
+	 * applied on game thread, the character ticks then skip their own computation.
+	 */
+	void UpdateEssentialValues();
+
+	struct FEntry
+	{
+		TWeakObjectPtr<AALSBaseCharacter> Character;
+
+		/** Components ticked right after the character */
+		TArray<TWeakObjectPtr<UActorComponent>, TInlineAllocator<2>> Components;
+
+		/** Dilated time since the character last ticked */
+		float PendingTime = 0.0f;
+
+		bool bTickThisFrame = false;
+	};
+
+	FALSCharacterTickFunction TickFunction;
+
+	TArray<FEntry> Entries;
+
+	/** Character of each essential values slot */
+	TArray<AALSBaseCharacter*> EssentialCharacters;
+
+	TArray<FALSEssentialValuesInput> EssentialInputs;
+
+	TArray<FALSEssentialValuesOutput> EssentialOutputs;
+};
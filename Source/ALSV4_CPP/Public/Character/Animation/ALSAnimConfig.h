@@ -0,0 +1,74 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Library/ALSAnimationStructLibrary.h"
+
+#include "ALSAnimConfig.generated.h"
+
+class UCurveFloat;
+class UCurveVector;
+class UAnimSequenceBase;
+
+/**
+ * Configuration of the ALS character anim instance. Every anim instance using the asset reads the same
+ * immutable copy, instances without an asset read the defaults of this class.
+ */
+UCLASS(BlueprintType)
+class ALSV4_CPP_API UALSAnimConfig : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Main Configuration", Meta = (ShowOnlyInnerProperties))
+	FALSAnimConfiguration Config;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Turn In Place", Meta = (ShowOnlyInnerProperties))
+	FALSAnimTurnInPlace TurnInPlace;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Rotate In Place", Meta = (ShowOnlyInnerProperties))
+	FALSAnimRotateInPlace RotateInPlace;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Significance", Meta = (ShowOnlyInnerProperties))
+	FALSAnimSignificanceSettings SignificanceSettings;
+
+	/** Blend Curves */
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Blend Curves")
+	UCurveFloat* DiagonalScaleAmountCurve = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Blend Curves")
+	UCurveFloat* StrideBlend_N_Walk = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Blend Curves")
+	UCurveFloat* StrideBlend_N_Run = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Blend Curves")
+	UCurveFloat* StrideBlend_C_Walk = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Blend Curves")
+	UCurveFloat* LandPredictionCurve = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Blend Curves")
+	UCurveFloat* LeanInAirCurve = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Blend Curves")
+	UCurveVector* YawOffset_FB = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Blend Curves")
+	UCurveVector* YawOffset_LR = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Dynamic Transition")
+	UAnimSequenceBase* TransitionAnim_R = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Dynamic Transition")
+	UAnimSequenceBase* TransitionAnim_L = nullptr;
+};
@@ -0,0 +1,90 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/SmartName.h"
+#include "Library/ALSCharacterEnumLibrary.h"
+
+struct FBlendedCurve;
+class USkeleton;
+
+/**
+ * Flat cache of the anim curves listed in EALSAnimCurve. Curve names are resolved to skeleton UIDs once, and all
+ * values are read by UID from the evaluated curve in a single pass, so no curve name is hashed or searched per frame.
+ */
+struct ALSV4_CPP_API FALSAnimCurveCache
+{
+	static constexpr int32 NumCurves = static_cast<int32>(EALSAnimCurve::MAX);
+	static_assert(NumCurves <= 64, "Changed curves are tracked in a 64 bit mask");
+
+	/** Curve of EALSAnimCurve and its UID on the skeleton */
+	struct FResolvedCurve
+	{
+		uint8 Index = 0;
+
+		SmartName::UID_Type UID = SmartName::MaxUID;
+	};
+
+	/** Resolve the curves which exist on given skeleton. Must be called on game thread. */
+	void Initialize(const USkeleton* Skeleton);
+
+	/** Read values of all resolved curves from given evaluated curve. Any thread. */
+	void Refresh(const FBlendedCurve& Curve);
+
+	void Reset();
+
+	float Get(EALSAnimCurve Curve) const
+	{
+		return Values[static_cast<int32>(Curve)];
+	}
+
+	float GetClamped(EALSAnimCurve Curve, float Bias, float ClampMin, float ClampMax) const
+	{
+		return FMath::Clamp(Get(Curve) + Bias, ClampMin, ClampMax);
+	}
+
+	/** True if any of the curves in given mask moved more than the change tolerance since it was last reported */
+	bool HasChanged(uint64 CurveMask) const
+	{
+		return (ChangedCurves & CurveMask) != 0;
+	}
+
+	/** Forget the reported changes, called once all readers of the changes are done */
+	void ClearChanged() { ChangedCurves = 0; }
+
+	static uint64 MakeMask(std::initializer_list<EALSAnimCurve> Curves)
+	{
+		uint64 Mask = 0;
+		for (const EALSAnimCurve Curve : Curves)
+		{
+			Mask |= uint64(1) << static_cast<int32>(Curve);
+		}
+		return Mask;
+	}
+
+	/** Smallest difference which reports a curve changed */
+	float ChangeTolerance = KINDA_SMALL_NUMBER;
+
+	static FName GetCurveName(EALSAnimCurve Curve);
+
+	/** Values and changes only, resolved curves are left as they are */
+	friend ALSV4_CPP_API FArchive& operator<<(FArchive& Ar, FALSAnimCurveCache& Cache);
+
+private:
+	float Values[NumCurves] = {};
+
+	/** Values at the last reported change, and the curves changed since the changes were cleared */
+	float ReportedValues[NumCurves] = {};
+
+	uint64 ChangedCurves = ~uint64(0);
+
+	/** Curves which exist on the skeleton, shared by every cache using the same skeleton */
+	TSharedPtr<const TArray<FResolvedCurve>> ResolvedCurves;
+};
@@ -0,0 +1,53 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Inputs a group of derived anim values was last computed from. New inputs are compared against the inputs of
+ * the last recomputation, not of the last frame, so drifts below the tolerance still add up to a change.
+ */
+template <int32 NumInputs>
+struct TALSAnimDirtyInputs
+{
+	/** Store given inputs if any of them moved more than Tolerance, true if the derived values must be recomputed */
+	bool Update(const float (&Inputs)[NumInputs], float Tolerance)
+	{
+		bool bChanged = !bValid;
+		for (int32 Index = 0; Index < NumInputs && !bChanged; ++Index)
+		{
+			bChanged = !FMath::IsNearlyEqual(Inputs[Index], Values[Index], Tolerance);
+		}
+
+		if (bChanged)
+		{
+			FMemory::Memcpy(Values, Inputs, sizeof(Values));
+			bValid = true;
+		}
+		return bChanged;
+	}
+
+	void Invalidate() { bValid = false; }
+
+	friend FArchive& operator<<(FArchive& Ar, TALSAnimDirtyInputs& Inputs)
+	{
+		for (float& Value : Inputs.Values)
+		{
+			Ar << Value;
+		}
+		Ar << Inputs.bValid;
+		return Ar;
+	}
+
+private:
+	float Values[NumInputs] = {};
+
+	bool bValid = false;
+};
@@ -0,0 +1,39 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimInstanceProxy.h"
+
+#include "ALSAnimInstanceProxy.generated.h"
+
+/**
+ * Proxy of UALSCharacterAnimInstance. Runs the thread safe part of the anim update and reads the curves of each
+ * evaluation, on a worker thread if the anim blueprint uses multi threaded animation update or evaluation.
+ */
+USTRUCT()
+struct ALSV4_CPP_API FALSAnimInstanceProxy : public FAnimInstanceProxy
+{
+	GENERATED_BODY()
+
+	FALSAnimInstanceProxy()
+	{
+	}
+
+	explicit FALSAnimInstanceProxy(UAnimInstance* InAnimInstance)
+		: FAnimInstanceProxy(InAnimInstance)
+	{
+	}
+
+protected:
+	virtual void Update(float DeltaSeconds) override;
+
+	/** Evaluates the graph itself to fill the curve cache straight from the evaluated curves of the main graph */
+	virtual bool Evaluate_WithRoot(FPoseContext& Output, FAnimNode_Base* InRootNode) override;
+};
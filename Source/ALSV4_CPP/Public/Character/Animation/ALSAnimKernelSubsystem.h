@@ -0,0 +1,80 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Library/ALSAnimKernels.h"
+
+#include "ALSAnimKernelSubsystem.generated.h"
+
+class AALSBaseCharacter;
+class UALSAnimKernelSubsystem;
+
+/** Runs the anim kernels once the registered characters ticked, and before their meshes update animation */
+USTRUCT()
+struct FALSAnimKernelTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	FALSAnimKernelTickFunction();
+
+	UALSAnimKernelSubsystem* Subsystem = nullptr;
+
+	// FTickFunction interface
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread,
+	                         const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+	// End of FTickFunction interface
+};
+
+template <>
+struct TStructOpsTypeTraits<FALSAnimKernelTickFunction> : public TStructOpsTypeTraitsBase2<FALSAnimKernelTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+/**
+ * Gathers the inputs of the anim value calculations of all registered characters into one batch, runs them
+ * as vectorized kernels and hands the results back to the anim instances.
+ */
+UCLASS()
+class ALSV4_CPP_API UALSAnimKernelSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	void RegisterCharacter(AALSBaseCharacter* Character);
+
+	void UnregisterCharacter(AALSBaseCharacter* Character);
+
+	void RunKernels();
+
+	/**
+	 * Times the per character calculations of the anim instances of all ALS characters in the world against
+	 * the batched kernels on the same characters, gather and scatter included
+	 */
+	void Benchmark(int32 Iterations) const;
+
+private:
+	FALSAnimKernelTickFunction TickFunction;
+
+	TArray<TWeakObjectPtr<AALSBaseCharacter>> Characters;
+
+	/** Character of each batch index, null where no input could be gathered */
+	TArray<AALSBaseCharacter*> BatchCharacters;
+
+	FALSAnimKernelBatch Batch;
+};
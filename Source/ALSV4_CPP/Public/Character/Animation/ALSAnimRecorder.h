@@ -0,0 +1,104 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPath.h"
+
+class UALSCharacterAnimInstance;
+class UWorld;
+
+/** Recorded thread safe updates of one anim instance */
+struct ALSV4_CPP_API FALSAnimRecordingTrack
+{
+	/** Name of the actor owning the anim instance */
+	FString Name;
+
+	FSoftClassPath AnimClass;
+
+	int32 NumFrames = 0;
+
+	/** Per frame: delta time, inputs, state before the update and checksum of the state after it */
+	TArray<uint8> Data;
+};
+
+/**
+ * Inputs of the thread safe anim update of several anim instances, stored as a compressed binary file.
+ * Recordings are only replayed by the version of the frame layout they are written with.
+ */
+struct ALSV4_CPP_API FALSAnimRecording
+{
+	static constexpr uint32 Magic = 0x524D4C41;
+
+	/** Increase whenever the recorded inputs or the state of the anim instance change */
+	static constexpr uint32 Version = 6;
+
+	TArray<FALSAnimRecordingTrack> Tracks;
+
+	bool Save(const FString& FileName) const;
+
+	bool Load(const FString& FileName);
+
+private:
+	void SerializeTracks(FArchive& Ar);
+};
+
+struct ALSV4_CPP_API FALSAnimReplayResult
+{
+	/** Replayed updates of a single iteration */
+	int32 NumFrames = 0;
+
+	/** Updates of the first iteration which didn't produce the recorded state */
+	int32 NumMismatches = 0;
+
+	FString FirstMismatch;
+
+	/** Time spent in the updates of all iterations */
+	double UpdateSeconds = 0.0;
+};
+
+/**
+ * Records the thread safe anim updates of ALS characters, and replays them on headless anim instances.
+ * Replays only run the thread safe update, the values it reads from the character, the traces and the
+ * evaluated curves come from the recording. Inputs are captured at the start of each update together with the
+ * state it continues from, so every replayed update starts exactly where the recorded one did, and the
+ * checksum of its result is compared bit for bit.
+ */
+class ALSV4_CPP_API FALSAnimRecorder
+{
+public:
+	/** Record the ALS anim instances of given world, anim instances created later are not recorded */
+	static void Start(UWorld* World);
+
+	/** Stop recording and save the tracks to given file */
+	static bool Stop(const FString& FileName);
+
+	static bool IsRecording();
+
+	/** Called by the anim instance before and after its thread safe update. Any thread. */
+	static void RecordUpdateStart(UALSCharacterAnimInstance& AnimInstance, float DeltaSeconds);
+
+	static void RecordUpdateEnd(UALSCharacterAnimInstance& AnimInstance);
+
+	/** Replay all tracks of given recording, Iterations times. False if a track can't be replayed. */
+	static bool Replay(const FALSAnimRecording& Recording, int32 Iterations, FALSAnimReplayResult& OutResult);
+
+	/** Load and replay given recording and log the results, true if every update matched the recording */
+	static bool ReplayFile(const FString& FileName, int32 Iterations);
+
+	static FString GetDefaultFileName();
+
+private:
+	static void SerializeInputs(FArchive& Ar, UALSCharacterAnimInstance& AnimInstance);
+
+	/** Values the update continues from, everything it writes to */
+	static void SerializeState(FArchive& Ar, UALSCharacterAnimInstance& AnimInstance);
+
+	static uint32 GetStateChecksum(UALSCharacterAnimInstance& AnimInstance);
+};
@@ -10,29 +10,115 @@
 
 #include "CoreMinimal.h"
 #include "Animation/AnimInstance.h"
+#include "WorldCollision.h"
 #include "Library/ALSAnimationStructLibrary.h"
 #include "Library/ALSStructEnumLibrary.h"
+#include "Character/Animation/ALSAnimCurveCache.h"
+#include "Library/ALSDoubleBuffer.h"
+#include "Character/Animation/ALSAnimDirtyInputs.h"
+#include "Character/ALSBoneCache.h"
+#include "Library/ALSCurveLUT.h"
+#include "Library/ALSAnimKernels.h"
+#include "Character/ALSDeadlineSubsystem.h"
 
 #include "ALSCharacterAnimInstance.generated.h"
 
 class AALSBaseCharacter;
+class UALSAnimConfig;
 class UCurveFloat;
 class UAnimSequence;
 class UCurveVector;
+class FALSAnimRecorder;
+struct FALSAnimInstanceProxy;
+struct FALSAnimRecordingTrack;
+struct FALSCharacterFrameState;
 
 /**
  * Main anim instance class for character
  */
 UCLASS(Blueprintable, BlueprintType)
-class ALSV4_CPP_API UALSCharacterAnimInstance : public UAnimInstance
+class ALSV4_CPP_API UALSCharacterAnimInstance : public UAnimInstance, public IALSDeadlineReceiver
 {
 	GENERATED_BODY()
 
+	friend struct FALSAnimInstanceProxy;
+
+	friend class FALSAnimRecorder;
+
 public:
+	virtual void PostInitProperties() override;
+
+#if WITH_EDITOR
+	virtual void PostLoad() override;
+#endif
+
 	virtual void NativeInitializeAnimation() override;
 
 	virtual void NativeUpdateAnimation(float DeltaSeconds) override;
 
+	virtual void NativePostEvaluateAnimation() override;
+
+	// IALSDeadlineReceiver interface
+	virtual void OnDeadline(FALSDeadline& Deadline) override;
+	// End of IALSDeadlineReceiver interface
+
+	/** Value of given curve from the last evaluation, read through the curve cache */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Animation")
+	float GetCachedCurveValue(EALSAnimCurve Curve) const
+	{
+		return CurveCache.Get(Curve);
+	}
+
+	/** Print the memory layout of the anim instance, per update and shared parts */
+	static void LogMemoryLayout();
+
+	/** Anim config the instance reads, AnimConfig or the defaults of UALSAnimConfig if it is not set */
+	UFUNCTION(BlueprintPure, Category = "ALS|Anim Config")
+	UALSAnimConfig* GetActiveAnimConfig() const;
+
+	UFUNCTION(BlueprintPure, Category = "ALS|Anim Config")
+	FALSAnimConfiguration GetConfig() const;
+
+	UFUNCTION(BlueprintPure, Category = "ALS|Anim Config")
+	FALSAnimTurnInPlace GetTurnInPlaceValues() const;
+
+	UFUNCTION(BlueprintPure, Category = "ALS|Anim Config")
+	FALSAnimRotateInPlace GetRotateInPlace() const;
+
+	/**
+	 * Curves read by gameplay code, from the last evaluation. Lock free from any thread, the values are one frame
+	 * old for everything ticking before the mesh.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Animation")
+	FALSGameplayCurves GetGameplayCurves() const
+	{
+		return GameplayCurves.Read();
+	}
+
+	/** Zero all cached curve values, e.g. when the mesh stops evaluating its own pose */
+	void ResetCachedCurves();
+
+	/** Whether only the values behind the curves read by the character are updated, see AALSBaseCharacter */
+	bool IsServerAnimMode() const { return bServerAnimMode; }
+
+	/** Bone and socket indices of the owning component. Game thread only. */
+	FALSBoneCache& GetBoneCache();
+
+	/** Inputs of the batched anim kernels, false if the character can't use them. Game thread only. */
+	bool GetKernelInput(FALSAnimKernelInput& OutInput) const;
+
+	/** Results of the batched anim kernels, used instead of the per character calculations for this frame */
+	void SetKernelOutput(const FALSAnimKernelOutput& Output);
+
+	/** Values of the anim kernels from the per character calculations, for the kernel benchmark. Game thread only. */
+	void CalculateKernelValues(FALSAnimKernelOutput& OutOutput);
+
+protected:
+	virtual FAnimInstanceProxy* CreateAnimInstanceProxy() override;
+
+	virtual void DestroyAnimInstanceProxy(FAnimInstanceProxy* InProxy) override;
+
+public:
 	UFUNCTION(BlueprintCallable, Category = "ALS|Animation")
 	void PlayTransition(const FALSDynamicMontageParams& Parameters);
 
@@ -90,13 +176,34 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "ALS|Grounded")
 	bool CanDynamicTransition() const;
 
-	/** Return mutable reference of character information to edit them easily inside character class */
-	FALSAnimCharacterInformation& GetCharacterInformationMutable()
-	{
-		return CharacterInformation;
-	}
-
 private:
+	/**
+	 * Part of the anim update which only reads the values captured on the game thread.
+	 * Called by FALSAnimInstanceProxy, on a worker thread if multi threaded animation update is enabled.
+	 */
+	void NativeThreadSafeUpdateAnimation(float DeltaSeconds);
+
+	/** Copy the states and essential values the character published at the end of its tick */
+	void ApplyFrameState(const FALSCharacterFrameState& State);
+
+	/** Capture everything the thread safe update needs from the character, its movement component and the mesh */
+	void UpdateGameThreadValues();
+
+	/** Point the config parts to AnimConfig, or to the defaults if it is not set */
+	void BindAnimConfig();
+
+	/** Bind the config parts and the lookup tables of the blend curves, enough for the thread safe update */
+	void InitializeFromAnimConfig();
+
+	void UpdateSignificanceTier(float DeltaSeconds);
+
+	const FALSAnimTierSettings& GetTierSettings() const;
+
+	/** Lead the interpolated anim values by the frames URO skips until the next update */
+	void ExtrapolateSkippedFrames();
+
+	void RestoreExtrapolatedValues();
+
 	void PlayDynamicTransitionDelay();
 
 	void OnJumpedDelay();
@@ -111,6 +218,10 @@ private:
 
 	void UpdateFootIK(float DeltaSeconds);
 
+	void UpdateFootIKNodeInputs();
+
+	void UpdatePoseCacheNodeInputs();
+
 	void UpdateMovementValues(float DeltaSeconds);
 
 	void UpdateRotationValues();
@@ -121,7 +232,8 @@ private:
 
 	/** Foot IK */
 
-	void SetFootLocking(float DeltaSeconds, FName EnableFootIKCurve, FName FootLockCurve, FName IKFootBone,
+	void SetFootLocking(float DeltaSeconds, EALSAnimCurve EnableFootIKCurve, EALSAnimCurve FootLockCurve,
+	                    const FTransform& IKFootTransform,
 	                    float& CurFootLockAlpha, bool& UseFootLockCurve,
 	                    FVector& CurFootLockLoc, FRotator& CurFootLockRot);
 
@@ -131,8 +243,15 @@ private:
 
 	void ResetIKOffsets(float DeltaSeconds);
 
-	void SetFootOffsets(float DeltaSeconds, FName EnableFootIKCurve, FName IKFootBone, FName RootBone,
-	                    FVector& CurLocationTarget, FVector& CurLocationOffset, FRotator& CurRotationOffset);
+	void SetFootOffsets(float DeltaSeconds, EALSAnimCurve EnableFootIKCurve, const FVector& LocationTarget,
+	                    const FRotator& RotationTarget, FVector& CurLocationOffset, FRotator& CurRotationOffset);
+
+	void TraceFootOffsets(EALSAnimCurve EnableFootIKCurve, EALSBone IKFootBone, FTraceHandle& TraceHandle,
+	                      FALSFootIKTraceCache& TraceCache, FVector& OutLocationTarget, FRotator& OutRotationTarget);
+
+	void TraceLandPrediction();
+
+	void UpdateAnalyticLandPrediction();
 
 	/** Grounded */
 
@@ -166,10 +285,6 @@ private:
 
 	EALSMovementDirection CalculateMovementDirection() const;
 
-	/** Util */
-
-	float GetAnimCurveClamped(const FName& Name, float Bias, float ClampMin, float ClampMax) const;
-
 protected:
 	/** References */
 	UPROPERTY(BlueprintReadOnly)
@@ -245,59 +360,171 @@ protected:
 		ShowOnlyInnerProperties))
 	FALSAnimGraphFootIK FootIKValues;
 
-	/** Turn In Place */
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Configuration|Turn In Place", Meta = (
-		ShowOnlyInnerProperties))
-	FALSAnimTurnInPlace TurnInPlaceValues;
+	/** Inputs of the ALS Foot IK anim node, only updated if Config->bUseNativeFootIKNode is set */
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Read Only Data|Anim Graph - Foot IK")
+	FALSFootIKNodeInputs FootIKNodeInputs;
 
-	/** Rotate In Place */
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Configuration|Rotate In Place", Meta = (
-		ShowOnlyInnerProperties))
-	FALSAnimRotateInPlace RotateInPlace;
+	/** Inputs of the ALS Pose Cache Player anim node */
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Read Only Data|Anim Graph - Pose Cache")
+	FALSPoseCacheNodeInputs PoseCacheNodeInputs;
 
-	/** Configuration */
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Configuration|Main Configuration", Meta = (
-		ShowOnlyInnerProperties))
-	FALSAnimConfiguration Config;
+	/** Significance */
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Read Only Data|Significance")
+	EALSAnimSignificance SignificanceTier = EALSAnimSignificance::Full;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Read Only Data|Significance")
+	bool bServerAnimMode = false;
+
+	/** Configuration shared by every instance of the anim class, defaults of UALSAnimConfig if not set */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Configuration")
+	UALSAnimConfig* AnimConfig = nullptr;
+
+#if WITH_EDITORONLY_DATA
+	/** Configuration saved before it moved into AnimConfig, copied into an anim config asset on load */
+	UPROPERTY()
+	FALSAnimTurnInPlace TurnInPlaceValues_DEPRECATED;
 
-	/** Blend Curves */
+	UPROPERTY()
+	FALSAnimRotateInPlace RotateInPlace_DEPRECATED;
 
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Configuration|Blend Curves")
-	UCurveFloat* DiagonalScaleAmountCurve = nullptr;
+	UPROPERTY()
+	FALSAnimConfiguration Config_DEPRECATED;
 
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Configuration|Blend Curves")
-	UCurveFloat* StrideBlend_N_Walk = nullptr;
+	UPROPERTY()
+	FALSAnimSignificanceSettings SignificanceSettings_DEPRECATED;
 
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Configuration|Blend Curves")
-	UCurveFloat* StrideBlend_N_Run = nullptr;
+	UPROPERTY()
+	UCurveFloat* DiagonalScaleAmountCurve_DEPRECATED = nullptr;
 
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Configuration|Blend Curves")
-	UCurveFloat* StrideBlend_C_Walk = nullptr;
+	UPROPERTY()
+	UCurveFloat* StrideBlend_N_Walk_DEPRECATED = nullptr;
 
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Configuration|Blend Curves")
-	UCurveFloat* LandPredictionCurve = nullptr;
+	UPROPERTY()
+	UCurveFloat* StrideBlend_N_Run_DEPRECATED = nullptr;
 
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Configuration|Blend Curves")
-	UCurveFloat* LeanInAirCurve = nullptr;
+	UPROPERTY()
+	UCurveFloat* StrideBlend_C_Walk_DEPRECATED = nullptr;
 
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Configuration|Blend Curves")
-	UCurveVector* YawOffset_FB = nullptr;
+	UPROPERTY()
+	UCurveFloat* LandPredictionCurve_DEPRECATED = nullptr;
 
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Configuration|Blend Curves")
-	UCurveVector* YawOffset_LR = nullptr;
+	UPROPERTY()
+	UCurveFloat* LeanInAirCurve_DEPRECATED = nullptr;
 
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Configuration|Dynamic Transition")
-	UAnimSequenceBase* TransitionAnim_R = nullptr;
+	UPROPERTY()
+	UCurveVector* YawOffset_FB_DEPRECATED = nullptr;
 
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Configuration|Dynamic Transition")
-	UAnimSequenceBase* TransitionAnim_L = nullptr;
+	UPROPERTY()
+	UCurveVector* YawOffset_LR_DEPRECATED = nullptr;
+
+	UPROPERTY()
+	UAnimSequenceBase* TransitionAnim_R_DEPRECATED = nullptr;
+
+	UPROPERTY()
+	UAnimSequenceBase* TransitionAnim_L_DEPRECATED = nullptr;
+#endif
 
 private:
-	FTimerHandle OnPivotTimer;
+	/**
+	 * Members below are grouped by use: values every update reads and writes first, right after the anim graph
+	 * values above, then state only touched by some updates. als.AnimLayout reports the resulting layout.
+	 */
+
+	/** Parts of the active anim config, shared with the other instances */
+	const FALSAnimConfiguration* Config = nullptr;
+
+	const FALSAnimTurnInPlace* TurnInPlace = nullptr;
+
+	const FALSAnimRotateInPlace* RotateInPlace = nullptr;
+
+	const FALSAnimSignificanceSettings* SignificanceSettings = nullptr;
+
+	FALSAnimGameThreadValues GameThreadValues;
+
+	FALSAnimCurveCache CurveCache;
+
+	/** Written by the evaluation only */
+	TALSDoubleBuffer<FALSGameplayCurves> GameplayCurves;
+
+	void PublishGameplayCurves();
+
+	/** Velocity blend the velocity blend is interpolated to */
+	FALSVelocityBlend TargetVelocityBlend;
+
+	FALSAnimKernelOutput KernelOutput;
+
+	/** Frame the kernel output was set on */
+	uint64 KernelOutputFrame = 0;
+
+	/** World time of the next significance update */
+	float NextSignificanceUpdateTime = 0.0f;
+
+	/** Anim updates since the last foot IK and land prediction traces */
+	int32 UpdatesSinceTrace = 0;
+
+	/** Time the aiming angle stayed past the turn check angle */
+	float TurnInPlaceDelayTime = 0.0f;
 
-	FTimerHandle PlayDynamicTransitionTimer;
+	TEnumAsByte<EMovementMode> PrevMovementMode = MOVE_None;
 
-	FTimerHandle OnJumpedTimer;
+	bool bForceSyncFootIKTraces = false;
 
 	bool bCanPlayDynamicTransition = true;
+
+	FALSAnimExtrapolationState Extrapolation;
+
+	/** Inputs of the derived values at their last recomputation, see Config->bUseDirtyTracking */
+	TALSAnimDirtyInputs<5> StrideInputs;
+
+	TALSAnimDirtyInputs<4> VelocityBlendInputs;
+
+	TALSAnimDirtyInputs<1> DiagonalScaleInputs;
+
+	TALSAnimDirtyInputs<1> YawOffsetInputs;
+
+	/** Blend curves, evaluated through lookup tables when enabled */
+	FALSCurveFloatLUT DiagonalScaleAmountLUT;
+
+	FALSCurveFloatLUT StrideBlend_N_WalkLUT;
+
+	FALSCurveFloatLUT StrideBlend_N_RunLUT;
+
+	FALSCurveFloatLUT StrideBlend_C_WalkLUT;
+
+	FALSCurveFloatLUT LandPredictionLUT;
+
+	FALSCurveFloatLUT LeanInAirLUT;
+
+	FALSCurveVectorLUT YawOffset_FBLUT;
+
+	FALSCurveVectorLUT YawOffset_LRLUT;
+
+	/** Async foot IK traces requested on previous frame */
+	FTraceHandle FootIKTraceHandle_L;
+
+	FTraceHandle FootIKTraceHandle_R;
+
+	/** Last foot IK trace results, reused while the feet and the ground stay still */
+	FALSFootIKTraceCache FootIKTraceCache_L;
+
+	FALSFootIKTraceCache FootIKTraceCache_R;
+
+	/** Trajectory of the analytic land prediction, and the sweeps of its segments requested on a previous update */
+	FALSLandPredictionCache LandPredictionCache;
+
+	TArray<FTraceHandle, TFixedAllocator<FALSLandPredictionCache::MaxSegments>> LandPredictionTraceHandles;
+
+	FALSBoneCache BoneCache;
+
+	FALSDeadline OnPivotDeadline;
+
+	FALSDeadline PlayDynamicTransitionDeadline;
+
+	FALSDeadline OnJumpedDeadline;
+
+	/** Track the thread safe updates are recorded into, see FALSAnimRecorder */
+	FALSAnimRecordingTrack* RecordingTrack = nullptr;
+
+	/** Anim config the config parts point into */
+	const UALSAnimConfig* ActiveAnimConfig = nullptr;
 };
@@ -16,6 +16,7 @@
 
 class AALSBaseCharacter;
 class AALSPlayerController;
+struct FALSCharacterFrameState;
 
 /**
  * Main class for player camera movement behavior
@@ -26,8 +27,17 @@ class ALSV4_CPP_API UALSPlayerCameraBehavior : public UAnimInstance
 	GENERATED_BODY()
 
 public:
+	virtual void NativeUpdateAnimation(float DeltaSeconds) override;
+
 	void SetRotationMode(EALSRotationMode RotationMode);
 
+	/** Copy the states the character published at the end of its tick */
+	void SetFrameState(const FALSCharacterFrameState& State);
+
+	/** Character the states are read from, set by the camera manager on possess */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	AALSBaseCharacter* ControlledCharacter = nullptr;
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
 	EALSMovementState MovementState;
 
@@ -0,0 +1,155 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Library/ALSCharacterEnumLibrary.h"
+
+#include "ALSPoseCacheAsset.generated.h"
+
+class AALSBaseCharacter;
+class USkeleton;
+
+/**
+ * One baked locomotion cycle. Rotations of all bones are quantized to three int16 components per frame,
+ * translations are only stored for the bones which move away from their reference pose.
+ */
+USTRUCT()
+struct ALSV4_CPP_API FALSPoseCacheCycle
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, Category = "Cycle")
+	EALSGait Gait = EALSGait::Walking;
+
+	UPROPERTY(VisibleAnywhere, Category = "Cycle")
+	EALSStance Stance = EALSStance::Standing;
+
+	UPROPERTY(VisibleAnywhere, Category = "Cycle")
+	EALSOverlayState OverlayState = EALSOverlayState::Default;
+
+	/** Movement direction relative to the facing direction in degrees, unused by idle cycles */
+	UPROPERTY(VisibleAnywhere, Category = "Cycle")
+	float Direction = 0.0f;
+
+	/** Average speed of the character while the cycle was captured, zero for idle cycles */
+	UPROPERTY(VisibleAnywhere, Category = "Cycle")
+	float Speed = 0.0f;
+
+	/** Cycle length in seconds */
+	UPROPERTY(VisibleAnywhere, Category = "Cycle")
+	float Length = 1.0f;
+
+	UPROPERTY(VisibleAnywhere, Category = "Cycle")
+	int32 NumFrames = 0;
+
+	/** NumFrames * NumBones * 3 quantized quaternion components, W is rebuilt as a positive value */
+	UPROPERTY()
+	TArray<int16> Rotations;
+
+	/** NumFrames * NumTranslationTracks local translations */
+	UPROPERTY()
+	TArray<FVector> Translations;
+
+	bool IsIdle() const { return Speed <= KINDA_SMALL_NUMBER; }
+};
+
+/** Cycle of a pose cache asset and its blend weight */
+struct FALSPoseCacheSample
+{
+	int32 Cycle = INDEX_NONE;
+
+	float Weight = 0.0f;
+};
+
+/**
+ * Locomotion cycles baked from an ALS character by the ALSPoseCacheBake commandlet, for quantized
+ * speed, direction, gait, stance and overlay states. Played by the ALS Pose Cache Player anim node.
+ */
+UCLASS(BlueprintType)
+class ALSV4_CPP_API UALSPoseCacheAsset : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/** Bake Settings */
+
+	/** Character the cycles are captured from, its anim instance has to derive from UALSCharacterAnimInstance */
+	UPROPERTY(EditAnywhere, Category = "Bake Settings")
+	TSubclassOf<AALSBaseCharacter> CharacterClass;
+
+	UPROPERTY(EditAnywhere, Category = "Bake Settings")
+	TArray<EALSGait> Gaits = {EALSGait::Walking, EALSGait::Running, EALSGait::Sprinting};
+
+	UPROPERTY(EditAnywhere, Category = "Bake Settings")
+	TArray<EALSStance> Stances = {EALSStance::Standing};
+
+	UPROPERTY(EditAnywhere, Category = "Bake Settings")
+	TArray<EALSOverlayState> OverlayStates = {EALSOverlayState::Default};
+
+	/** Movement input amounts each gait is captured at, every amount gives a different speed */
+	UPROPERTY(EditAnywhere, Category = "Bake Settings", meta = (ClampMin = 0.05, ClampMax = 1))
+	TArray<float> InputAmounts = {0.5f, 1.0f};
+
+	/** Number of movement directions around the character. Sprint is only captured forward. */
+	UPROPERTY(EditAnywhere, Category = "Bake Settings", meta = (ClampMin = 1, ClampMax = 16))
+	int32 NumDirections = 8;
+
+	UPROPERTY(EditAnywhere, Category = "Bake Settings", meta = (ClampMin = 10, ClampMax = 120))
+	float SampleRate = 30.0f;
+
+	/** Time to let the character reach a steady state before capturing */
+	UPROPERTY(EditAnywhere, Category = "Bake Settings", meta = (ClampMin = 0))
+	float WarmupTime = 2.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Bake Settings", meta = (ClampMin = 0.1))
+	float MinCycleLength = 0.4f;
+
+	UPROPERTY(EditAnywhere, Category = "Bake Settings", meta = (ClampMin = 0.1))
+	float MaxCycleLength = 2.5f;
+
+	/** Bones whose translation stays within this distance of the reference pose don't get a translation track */
+	UPROPERTY(EditAnywhere, Category = "Bake Settings", meta = (ClampMin = 0))
+	float TranslationTolerance = 0.1f;
+
+	/** Baked Data */
+
+	UPROPERTY(VisibleAnywhere, Category = "Baked Data")
+	USkeleton* Skeleton = nullptr;
+
+	UPROPERTY(VisibleAnywhere, Category = "Baked Data")
+	TArray<FName> BoneNames;
+
+	/** Indices into BoneNames of the bones which have translations */
+	UPROPERTY(VisibleAnywhere, Category = "Baked Data")
+	TArray<int32> TranslationTracks;
+
+	UPROPERTY(VisibleAnywhere, Category = "Baked Data")
+	TArray<FALSPoseCacheCycle> Cycles;
+
+	/**
+	 * Cycles to blend for given state, with the play rate which matches the speed of the character.
+	 * Cycles of the closest two directions and the closest two speeds of the gait are blended.
+	 */
+	void FindSamples(EALSGait Gait, EALSStance Stance, EALSOverlayState OverlayState, float Speed,
+	                 float Direction, TArray<FALSPoseCacheSample, TInlineAllocator<4>>& OutSamples,
+	                 float& OutPlayRate) const;
+
+	FQuat GetRotation(const FALSPoseCacheCycle& Cycle, int32 Frame, int32 Bone) const;
+
+	FVector GetTranslation(const FALSPoseCacheCycle& Cycle, int32 Frame, int32 Track) const
+	{
+		return Cycle.Translations[Frame * TranslationTracks.Num() + Track];
+	}
+
+	static void QuantizeRotation(const FQuat& Rotation, int16* OutComponents);
+
+	static FQuat DequantizeRotation(const int16* Components);
+};
@@ -0,0 +1,113 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BoneControllers/AnimNode_SkeletalControlBase.h"
+#include "Library/ALSAnimationStructLibrary.h"
+
+#include "AnimNode_ALSFootIK.generated.h"
+
+/**
+ * Computes foot locking, foot offsets and pelvis offset from the component space pose and applies them
+ * to the ik foot bones and the pelvis. Runs during evaluation, so nothing is read from the game thread
+ * except the inputs. Leg IK still has to be solved towards the ik foot bones after this node.
+ */
+USTRUCT(BlueprintInternalUseOnly)
+struct ALSV4_CPP_API FAnimNode_ALSFootIK : public FAnimNode_SkeletalControlBase
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inputs", meta = (PinShownByDefault))
+	FALSFootIKNodeInputs Inputs;
+
+	UPROPERTY(EditAnywhere, Category = "Settings")
+	FBoneReference IKFootBone_L;
+
+	UPROPERTY(EditAnywhere, Category = "Settings")
+	FBoneReference IKFootBone_R;
+
+	UPROPERTY(EditAnywhere, Category = "Settings")
+	FBoneReference PelvisBone;
+
+	UPROPERTY(EditAnywhere, Category = "Settings")
+	bool bApplyFootLocking = true;
+
+	UPROPERTY(EditAnywhere, Category = "Settings")
+	bool bApplyFootOffsets = true;
+
+	UPROPERTY(EditAnywhere, Category = "Settings")
+	bool bApplyPelvisOffset = true;
+
+	/** Longest interpolation step, evaluations after skipped frames are split in equal steps */
+	UPROPERTY(EditAnywhere, Category = "Settings", meta = (ClampMin = 0.001))
+	float MaxInterpSubstep = 0.0333f;
+
+	FAnimNode_ALSFootIK();
+
+	const FALSAnimGraphFootIK& GetFootIKValues() const { return FootIKValues; }
+
+	// FAnimNode_Base interface
+	virtual void Initialize_AnyThread(const FAnimationInitializeContext& Context) override;
+	virtual void GatherDebugData(FNodeDebugData& DebugData) override;
+	// End of FAnimNode_Base interface
+
+	// FAnimNode_SkeletalControlBase interface
+	virtual void UpdateInternal(const FAnimationUpdateContext& Context) override;
+	virtual void EvaluateSkeletalControl_AnyThread(FComponentSpacePoseContext& Output,
+	                                               TArray<FBoneTransform>& OutBoneTransforms) override;
+	virtual bool IsValidToEvaluate(const USkeleton* Skeleton, const FBoneContainer& RequiredBones) override;
+	// End of FAnimNode_SkeletalControlBase interface
+
+private:
+	// FAnimNode_SkeletalControlBase interface
+	virtual void InitializeBoneReferences(const FBoneContainer& RequiredBones) override;
+	// End of FAnimNode_SkeletalControlBase interface
+
+	enum ECurve
+	{
+		Curve_EnableFootIK_L,
+		Curve_EnableFootIK_R,
+		Curve_FootLock_L,
+		Curve_FootLock_R,
+		Curve_RotationAmount,
+		Curve_Num
+	};
+
+	float GetCurveValue(const FComponentSpacePoseContext& Output, ECurve Curve) const;
+
+	void SetFootLocking(float DeltaSeconds, float EnableFootIK, float FootLock, float RotationAmount,
+	                    const FTransform& IKFootTransform, float& CurFootLockAlpha, bool& UseFootLockCurve,
+	                    FVector& CurFootLockLoc, FRotator& CurFootLockRot) const;
+
+	void SetFootLockOffsets(float DeltaSeconds, FVector& LocalLoc, FRotator& LocalRot) const;
+
+	void SetFootOffsets(float DeltaSeconds, float EnableFootIK, const FVector& LocationTarget,
+	                    const FRotator& RotationTarget, FVector& CurLocationOffset, FRotator& CurRotationOffset) const;
+
+	void SetPelvisIKOffset(float DeltaSeconds, float EnableFootIK_L, float EnableFootIK_R,
+	                       const FVector& FootOffsetLTarget, const FVector& FootOffsetRTarget);
+
+	void ResetIKOffsets(float DeltaSeconds);
+
+	FTransform ApplyFoot(const FTransform& IKFootTransform, const FQuat& ComponentRotation, float FootLockAlpha,
+	                     const FVector& FootLockLocation, const FRotator& FootLockRotation,
+	                     const FVector& FootOffsetLocation, const FRotator& FootOffsetRotation) const;
+
+	/** Foot lock and offset state, owned by the node */
+	FALSAnimGraphFootIK FootIKValues;
+
+	/** Delta time accumulated by updates since the last evaluation */
+	float PendingDeltaTime = 0.0f;
+
+	/** Set by the update when the anim instance runs in server anim mode */
+	bool bSkipped = false;
+
+	SmartName::UID_Type CurveUIDs[Curve_Num];
+};
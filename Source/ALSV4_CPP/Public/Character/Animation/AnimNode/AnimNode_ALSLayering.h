@@ -0,0 +1,147 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimNodeBase.h"
+
+#include "AnimNode_ALSLayering.generated.h"
+
+/**
+ * Blends the overlay layer over the base layer per body part, driven by the Layering_* curves of the overlay
+ * and BasePose_* curves of the base layer. Additive of the base layer over its base pose is applied to the
+ * overlay in local space, or in mesh space for the spine and the arms, in a single pass over the bones.
+ */
+USTRUCT(BlueprintInternalUseOnly)
+struct ALSV4_CPP_API FAnimNode_ALSLayering : public FAnimNode_Base
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Links")
+	FPoseLink BaseLayer;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Links")
+	FPoseLink OverlayLayer;
+
+	/** Base pose of the base layer while standing, weighted by the BasePose_N curve */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Links")
+	FPoseLink BasePose_N;
+
+	/** Base pose of the base layer while crouching, weighted by the BasePose_CLF curve */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Links")
+	FPoseLink BasePose_CLF;
+
+	/** Bones which start each body part, body part of a bone is the one of its closest listed ancestor */
+	UPROPERTY(EditAnywhere, Category = "Settings")
+	FName PelvisBone = FName(TEXT("pelvis"));
+
+	UPROPERTY(EditAnywhere, Category = "Settings")
+	FName ThighBone_L = FName(TEXT("thigh_l"));
+
+	UPROPERTY(EditAnywhere, Category = "Settings")
+	FName ThighBone_R = FName(TEXT("thigh_r"));
+
+	UPROPERTY(EditAnywhere, Category = "Settings")
+	FName SpineBone = FName(TEXT("spine_01"));
+
+	UPROPERTY(EditAnywhere, Category = "Settings")
+	FName HeadBone = FName(TEXT("neck_01"));
+
+	UPROPERTY(EditAnywhere, Category = "Settings")
+	FName ClavicleBone_L = FName(TEXT("clavicle_l"));
+
+	UPROPERTY(EditAnywhere, Category = "Settings")
+	FName ClavicleBone_R = FName(TEXT("clavicle_r"));
+
+	UPROPERTY(EditAnywhere, Category = "Settings")
+	FName HandBone_L = FName(TEXT("hand_l"));
+
+	UPROPERTY(EditAnywhere, Category = "Settings")
+	FName HandBone_R = FName(TEXT("hand_r"));
+
+	FAnimNode_ALSLayering();
+
+	enum EBodyPart : uint8
+	{
+		BodyPart_None,
+		BodyPart_Legs,
+		BodyPart_Pelvis,
+		BodyPart_Spine,
+		BodyPart_Head,
+		BodyPart_Arm_L,
+		BodyPart_Arm_R,
+		BodyPart_Hand_L,
+		BodyPart_Hand_R,
+		BodyPart_Num
+	};
+
+	/** Weights of a body part for the current evaluation */
+	struct FBodyPartWeights
+	{
+		/** Weight of the overlay layer over the base layer */
+		float Overlay = 0.0f;
+
+		/** Weight of the local space additive of the base layer */
+		float AdditiveLS = 0.0f;
+
+		/** Weight of the mesh space additive of the base layer */
+		float AdditiveMS = 0.0f;
+	};
+
+	/**
+	 * Layers the overlay over the base pose in Pose by the weights of the body part of each bone. Reference is the
+	 * base pose of the base layer, the additives applied to the overlay are the difference of the base layer to it.
+	 */
+	static void LayerPoses(FCompactPose& Pose, const FCompactPose& Overlay, const FCompactPose& Reference,
+	                       const FBodyPartWeights (&Weights)[BodyPart_Num], const TArray<uint8>& BodyParts);
+
+	// FAnimNode_Base interface
+	virtual void Initialize_AnyThread(const FAnimationInitializeContext& Context) override;
+	virtual void CacheBones_AnyThread(const FAnimationCacheBonesContext& Context) override;
+	virtual void Update_AnyThread(const FAnimationUpdateContext& Context) override;
+	virtual void Evaluate_AnyThread(FPoseContext& Output) override;
+	virtual void GatherDebugData(FNodeDebugData& DebugData) override;
+	// End of FAnimNode_Base interface
+
+private:
+	enum ECurve : uint8
+	{
+		Curve_BasePose_N,
+		Curve_BasePose_CLF,
+		Curve_Legs,
+		Curve_Legs_Add,
+		Curve_Pelvis,
+		Curve_Pelvis_Add,
+		Curve_Spine,
+		Curve_Spine_Add,
+		Curve_Head,
+		Curve_Head_Add,
+		Curve_Arm_L,
+		Curve_Arm_L_Add,
+		Curve_Arm_L_LS,
+		Curve_Arm_R,
+		Curve_Arm_R_Add,
+		Curve_Arm_R_LS,
+		Curve_Hand_L,
+		Curve_Hand_R,
+		Curve_Num
+	};
+
+	void CacheBodyParts(const FBoneContainer& RequiredBones);
+
+	static float GetCurveValue(const FBlendedCurve& Curve, SmartName::UID_Type UID);
+
+	/** Body part of each compact pose bone */
+	TArray<uint8> BodyParts;
+
+	/** Set by the update when the anim instance runs in server anim mode */
+	bool bBaseLayerOnly = false;
+
+	SmartName::UID_Type CurveUIDs[Curve_Num];
+};
@@ -0,0 +1,75 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimNodeBase.h"
+#include "Character/Animation/ALSPoseCacheAsset.h"
+
+#include "AnimNode_ALSPoseCachePlayer.generated.h"
+
+/**
+ * Plays the baked locomotion cycles of an ALS pose cache asset, blended by speed and movement direction
+ * and sampled at a shared phase. Replacement of the full ALS graph for far characters: placed after the ALS graph,
+ * it passes the graph through until it gets active and then neither updates nor evaluates it anymore.
+ * Bind the inputs to the pose cache node inputs of the ALS anim instance to switch with its significance tier.
+ */
+USTRUCT(BlueprintInternalUseOnly)
+struct ALSV4_CPP_API FAnimNode_ALSPoseCachePlayer : public FAnimNode_Base
+{
+	GENERATED_BODY()
+
+	/** ALS graph played while the pose cache isn't active */
+	UPROPERTY(EditAnywhere, Category = "Links")
+	FPoseLink Source;
+
+	UPROPERTY(EditAnywhere, Category = "Settings", meta = (PinHiddenByDefault))
+	UALSPoseCacheAsset* PoseCache = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inputs", meta = (PinShownByDefault))
+	bool bActive = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inputs", meta = (PinShownByDefault))
+	float Speed = 0.0f;
+
+	/** Movement direction relative to the facing direction in degrees */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inputs", meta = (PinShownByDefault))
+	float Direction = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inputs", meta = (PinShownByDefault))
+	EALSGait Gait = EALSGait::Walking;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inputs", meta = (PinShownByDefault))
+	EALSStance Stance = EALSStance::Standing;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inputs", meta = (PinShownByDefault))
+	EALSOverlayState OverlayState = EALSOverlayState::Default;
+
+	// FAnimNode_Base interface
+	virtual void Initialize_AnyThread(const FAnimationInitializeContext& Context) override;
+	virtual void CacheBones_AnyThread(const FAnimationCacheBonesContext& Context) override;
+	virtual void Update_AnyThread(const FAnimationUpdateContext& Context) override;
+	virtual void Evaluate_AnyThread(FPoseContext& Output) override;
+	virtual void GatherDebugData(FNodeDebugData& DebugData) override;
+	// End of FAnimNode_Base interface
+
+private:
+	void CacheCompactBones(const FBoneContainer& RequiredBones);
+
+	/** Compact pose index of each bone of the pose cache, INDEX_NONE if the bone is not required */
+	TArray<int32> CompactBones;
+
+	/** Pose cache the compact bones are resolved for */
+	const UALSPoseCacheAsset* CachedPoseCache = nullptr;
+
+	TArray<FALSPoseCacheSample, TInlineAllocator<4>> Samples;
+
+	/** Normalized time of all sampled cycles */
+	float Phase = 0.0f;
+};
@@ -0,0 +1,138 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Library/ALSAnimationStructLibrary.h"
+
+/** Inputs of the anim kernels of one character, the values its anim instance reads for the same calculations */
+struct FALSAnimKernelInput
+{
+	FVector Velocity = FVector::ZeroVector;
+
+	FVector Acceleration = FVector::ZeroVector;
+
+	/** Yaw of the actor rotation. Kernels assume the actor has no pitch and roll, as ALS characters do. */
+	float Yaw = 0.0f;
+
+	float Speed = 0.0f;
+
+	/** Value of the W_Gait curve */
+	float GaitCurve = 0.0f;
+
+	float MeshScaleZ = 1.0f;
+
+	float MaxAcceleration = 0.0f;
+
+	float MaxBrakingDeceleration = 0.0f;
+
+	float AnimatedWalkSpeed = 150.0f;
+
+	float AnimatedRunSpeed = 350.0f;
+
+	float AnimatedSprintSpeed = 600.0f;
+
+	float AnimatedCrouchSpeed = 150.0f;
+};
+
+/**
+ * Results of the anim kernels of one character. Play rates are not divided by the stride blend, and the air lean
+ * is not scaled by the lean in air curve yet, both curves are evaluated by the anim instance.
+ */
+struct FALSAnimKernelOutput
+{
+	FALSVelocityBlend VelocityBlend;
+
+	FVector RelativeAcceleration = FVector::ZeroVector;
+
+	float StandingSpeedRate = 0.0f;
+
+	float CrouchingSpeedRate = 0.0f;
+
+	FALSLeanAmount AirLean;
+};
+
+/**
+ * Kernel inputs and outputs of many characters, stored as one array per component and processed four characters
+ * at a time with vector registers. The kernels match CalculateVelocityBlend, CalculateRelativeAccelerationAmount,
+ * CalculateStandingPlayRate, CalculateCrouchingPlayRate and CalculateAirLeanAmount of the anim instance.
+ */
+struct ALSV4_CPP_API FALSAnimKernelBatch
+{
+	/** Resize the batch, inputs of all characters are reset */
+	void SetNum(int32 NumCharacters);
+
+	int32 Num() const { return NumCharacters; }
+
+	void SetInput(int32 Index, const FALSAnimKernelInput& Input);
+
+	void GetOutput(int32 Index, FALSAnimKernelOutput& Output) const;
+
+	/** Run the kernels on all characters, blocks of characters are spread over worker threads if allowed */
+	void Run(bool bParallel);
+
+private:
+	enum EStream
+	{
+		VelocityX,
+		VelocityY,
+		VelocityZ,
+		AccelerationX,
+		AccelerationY,
+		AccelerationZ,
+		Yaw,
+		Speed,
+		GaitCurve,
+		InvMeshScaleZ,
+		MaxAcceleration,
+		MaxBrakingDeceleration,
+		InvAnimatedWalkSpeed,
+		InvAnimatedRunSpeed,
+		InvAnimatedSprintSpeed,
+		InvAnimatedCrouchSpeed,
+
+		VelocityBlendF,
+		VelocityBlendB,
+		VelocityBlendL,
+		VelocityBlendR,
+		RelativeAccelerationX,
+		RelativeAccelerationY,
+		RelativeAccelerationZ,
+		StandingSpeedRate,
+		CrouchingSpeedRate,
+		AirLeanLR,
+		AirLeanFB,
+
+		NumStreams
+	};
+
+	float* Stream(EStream Id) { return Data.GetData() + Id * Stride; }
+
+	const float* Stream(EStream Id) const { return Data.GetData() + Id * Stride; }
+
+	/** Run the kernels on given range of 4 character groups */
+	void RunGroups(int32 FirstGroup, int32 NumGroups);
+
+	/** All streams, each one Stride floats long */
+	TArray<float, TAlignedHeapAllocator<16>> Data;
+
+	int32 NumCharacters = 0;
+
+	/** Number of characters rounded up to a multiple of 4 */
+	int32 Stride = 0;
+};
+
+namespace ALSAnimKernels
+{
+	/** Scalar version of the kernels for a single character */
+	ALSV4_CPP_API void Compute(const FALSAnimKernelInput& Input, FALSAnimKernelOutput& Output);
+
+	/** Largest difference of any output value */
+	ALSV4_CPP_API float MaxError(const FALSAnimKernelOutput& A, const FALSAnimKernelOutput& B);
+}
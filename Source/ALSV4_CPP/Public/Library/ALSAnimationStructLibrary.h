@@ -10,6 +10,7 @@
 
 #include "CoreMinimal.h"
 #include "Runtime/Engine/Classes/Animation/AnimSequenceBase.h"
+#include "Components/PrimitiveComponent.h"
 #include "ALSCharacterEnumLibrary.h"
 
 
@@ -137,6 +138,215 @@ struct FALSAnimCharacterInformation
 };
 
 
+/**
+ * Values owned by the character, its movement component or the mesh which are captured on the game thread,
+ * so the rest of the anim update can run on a worker thread without touching any UObject.
+ */
+USTRUCT()
+struct FALSAnimGameThreadValues
+{
+	GENERATED_BODY()
+
+	/** False when there is no character to update from, or the update has no delta time (e.g. editor preview) */
+	bool bValid = false;
+
+	bool bIsMovingOnGround = false;
+
+	bool bIsAutonomousProxy = false;
+
+	/** Results of the batched anim kernels were set this frame */
+	bool bHasKernelOutput = false;
+
+	float MaxAcceleration = 0.0f;
+
+	float MaxBrakingDeceleration = 0.0f;
+
+	float MeshScaleZ = 1.0f;
+
+	/** 1 / URO update rate of the owning mesh */
+	float UpdateRateScale = 1.0f;
+
+	FRotator MeshRotation = FRotator::ZeroRotator;
+
+	FRotator LastUpdateRotation = FRotator::ZeroRotator;
+
+	/** Component space transforms of the IK foot bones */
+	FTransform IKFoot_L = FTransform::Identity;
+
+	FTransform IKFoot_R = FTransform::Identity;
+
+	/** Foot offset targets found by the ground traces. Zero if the surface below the foot is not walkable. */
+	FVector FootOffset_L_Target = FVector::ZeroVector;
+
+	FVector FootOffset_R_Target = FVector::ZeroVector;
+
+	FRotator FootOffset_L_RotationTarget = FRotator::ZeroRotator;
+
+	FRotator FootOffset_R_RotationTarget = FRotator::ZeroRotator;
+
+	/** Hit time of the land prediction sweep, negative if no walkable surface is found */
+	float LandPredictionTime = -1.0f;
+
+	float RagdollVelocity = 0.0f;
+
+	/** Weights of the features the significance tier can disable, blended when the tier changes */
+	float FootIKTraceWeight = 1.0f;
+
+	float LandPredictionWeight = 1.0f;
+
+	float AimSmoothingWeight = 1.0f;
+};
+
+/**
+ * Anim values of the last update, while the anim instance shows their extrapolated values.
+ */
+USTRUCT()
+struct FALSAnimExtrapolationState
+{
+	GENERATED_BODY()
+
+	bool bApplied = false;
+
+	FALSVelocityBlend VelocityBlend;
+
+	FALSLeanAmount LeanAmount;
+
+	FRotator SmoothedAimingRotation = FRotator::ZeroRotator;
+
+	/** Derived from the smoothed aiming rotation, the anim graph reads the angle */
+	FVector2D SmoothedAimingAngle = FVector2D::ZeroVector;
+
+	FVector FootOffset_L_Location = FVector::ZeroVector;
+
+	FVector FootOffset_R_Location = FVector::ZeroVector;
+
+	FRotator FootOffset_L_Rotation = FRotator::ZeroRotator;
+
+	FRotator FootOffset_R_Rotation = FRotator::ZeroRotator;
+};
+
+/**
+ * Ballistic trajectory of a falling character and the time it is predicted to land on a walkable surface.
+ */
+USTRUCT()
+struct FALSLandPredictionCache
+{
+	GENERATED_BODY()
+
+	/** Time segments the fall after the apex is swept in, each is swept along its chord */
+	static constexpr int32 NumFallSegments = 4;
+
+	static constexpr int32 MaxSegments = NumFallSegments + 1;
+
+	bool bValid = false;
+
+	/** World time the trajectory starts at */
+	float StartTime = 0.0f;
+
+	FVector StartLocation = FVector::ZeroVector;
+
+	FVector StartVelocity = FVector::ZeroVector;
+
+	/** Seconds from the start to the impact, negative if no walkable surface is found */
+	float ImpactTime = -1.0f;
+
+	/** Seconds from the start each swept segment begins at, followed by the end of the last segment */
+	TArray<float, TFixedAllocator<MaxSegments + 1>> SegmentTimes;
+
+	FVector GetVelocity(float Time, float GravityZ) const
+	{
+		return StartVelocity + FVector(0.0f, 0.0f, GravityZ * (Time - StartTime));
+	}
+
+	FVector GetLocation(float Time, float GravityZ) const
+	{
+		const float Elapsed = Time - StartTime;
+		return StartLocation + StartVelocity * Elapsed + FVector(0.0f, 0.0f, 0.5f * GravityZ * Elapsed * Elapsed);
+	}
+
+	/** Later of the times the trajectory passes given height, negative if it never does */
+	float GetTimeAtHeight(float Z, float GravityZ) const
+	{
+		const float A = 0.5f * GravityZ;
+		const float B = StartVelocity.Z;
+		const float C = StartLocation.Z - Z;
+		if (FMath::IsNearlyZero(A))
+		{
+			return B < 0.0f ? -C / B : -1.0f;
+		}
+
+		const float Discriminant = B * B - 4.0f * A * C;
+		return Discriminant >= 0.0f ? (-B - FMath::Sqrt(Discriminant)) / (2.0f * A) : -1.0f;
+	}
+
+	/** Splits the trajectory up to given time at the apex, then into equal time segments */
+	void SetSegments(float EndTime, float GravityZ)
+	{
+		SegmentTimes.Reset();
+		SegmentTimes.Add(0.0f);
+
+		const float ApexTime = GravityZ < 0.0f ? -StartVelocity.Z / GravityZ : 0.0f;
+		if (ApexTime > 0.0f && ApexTime < EndTime)
+		{
+			SegmentTimes.Add(ApexTime);
+		}
+
+		const float FallStartTime = SegmentTimes.Last();
+		for (int32 Segment = 1; Segment <= NumFallSegments; ++Segment)
+		{
+			SegmentTimes.Add(FMath::Lerp(FallStartTime, EndTime, static_cast<float>(Segment) / NumFallSegments));
+		}
+	}
+};
+
+/**
+ * Last foot IK ground trace result of a foot.
+ */
+USTRUCT()
+struct FALSFootIKTraceCache
+{
+	GENERATED_BODY()
+
+	bool bValid = false;
+
+	bool bWalkable = false;
+
+	FVector FootLocation = FVector::ZeroVector;
+
+	FVector ImpactPoint = FVector::ZeroVector;
+
+	FVector ImpactNormal = FVector::ZeroVector;
+
+	TWeakObjectPtr<UPrimitiveComponent> HitComponent;
+
+	FTransform HitComponentTransform = FTransform::Identity;
+
+	void Store(const FVector& InFootLocation, const FHitResult& HitResult, bool bInWalkable)
+	{
+		UPrimitiveComponent* Component = HitResult.GetComponent();
+
+		// Only blocking hits on a component can be tracked for movement
+		bValid = HitResult.bBlockingHit && Component;
+		bWalkable = bInWalkable;
+		FootLocation = InFootLocation;
+		ImpactPoint = HitResult.ImpactPoint;
+		ImpactNormal = HitResult.ImpactNormal;
+		HitComponent = Component;
+		HitComponentTransform = Component ? Component->GetComponentTransform() : FTransform::Identity;
+	}
+
+	bool CanReuse(const FVector& InFootLocation, float Epsilon) const
+	{
+		if (!bValid || FVector::DistSquared2D(FootLocation, InFootLocation) > FMath::Square(Epsilon))
+		{
+			return false;
+		}
+
+		const UPrimitiveComponent* Component = HitComponent.Get();
+		return Component && Component->GetComponentTransform().Equals(HitComponentTransform, KINDA_SMALL_NUMBER);
+	}
+};
+
 USTRUCT(BlueprintType)
 struct FALSAnimGraphGrounded
 {
@@ -329,51 +539,199 @@ struct FALSAnimGraphFootIK
 	float FootLock_R_Alpha = 0.0f;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
-	bool UseFootLockCurve_L;
+	bool UseFootLockCurve_L = false;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
-	bool UseFootLockCurve_R;
+	bool UseFootLockCurve_R = false;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
-	FVector FootLock_L_Location;
+	FVector FootLock_L_Location = FVector::ZeroVector;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
-	FVector TargetFootLock_R_Location;
+	FVector TargetFootLock_R_Location = FVector::ZeroVector;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
-	FVector FootLock_R_Location;
+	FVector FootLock_R_Location = FVector::ZeroVector;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
-	FRotator TargetFootLock_L_Rotation;
+	FRotator TargetFootLock_L_Rotation = FRotator::ZeroRotator;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
-	FRotator FootLock_L_Rotation;
+	FRotator FootLock_L_Rotation = FRotator::ZeroRotator;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
-	FRotator TargetFootLock_R_Rotation;
+	FRotator TargetFootLock_R_Rotation = FRotator::ZeroRotator;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
-	FRotator FootLock_R_Rotation;
+	FRotator FootLock_R_Rotation = FRotator::ZeroRotator;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
-	FVector FootOffset_L_Location;
+	FVector FootOffset_L_Location = FVector::ZeroVector;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
-	FVector FootOffset_R_Location;
+	FVector FootOffset_R_Location = FVector::ZeroVector;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
-	FRotator FootOffset_L_Rotation;
+	FRotator FootOffset_L_Rotation = FRotator::ZeroRotator;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
-	FRotator FootOffset_R_Rotation;
+	FRotator FootOffset_R_Rotation = FRotator::ZeroRotator;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
-	FVector PelvisOffset;
+	FVector PelvisOffset = FVector::ZeroVector;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
 	float PelvisAlpha = 0.0f;
 };
 
+/**
+ * Game thread values the ALS Foot IK anim node needs to compute foot locking and offsets during evaluation.
+ */
+USTRUCT(BlueprintType)
+struct FALSFootIKNodeInputs
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
+	bool bInAir = false;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
+	bool bRagdoll = false;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
+	bool bIsAutonomousProxy = false;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
+	float UpdateRateScale = 1.0f;
+
+	/** Character velocity relative to the mesh rotation */
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
+	FVector LocalVelocity = FVector::ZeroVector;
+
+	/** Rotation of the character since the last movement update, zero when not moving on ground */
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
+	FRotator RotationDifference = FRotator::ZeroRotator;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
+	FVector FootOffset_L_Target = FVector::ZeroVector;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
+	FVector FootOffset_R_Target = FVector::ZeroVector;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
+	FRotator FootOffset_L_RotationTarget = FRotator::ZeroRotator;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
+	FRotator FootOffset_R_RotationTarget = FRotator::ZeroRotator;
+};
+
+/**
+ * Game thread values the ALS Pose Cache Player anim node needs, set while the character is in the pose cache tier.
+ */
+USTRUCT(BlueprintType)
+struct FALSPoseCacheNodeInputs
+{
+	GENERATED_BODY()
+
+	/** Play the pose cache instead of the ALS graph linked to the node */
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
+	bool bActive = false;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
+	float Speed = 0.0f;
+
+	/** Movement direction relative to the facing direction in degrees */
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
+	float Direction = 0.0f;
+};
+
+/**
+ * Anim features which run in a significance tier
+ */
+USTRUCT(BlueprintType)
+struct FALSAnimTierSettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	bool bFootIKTraces = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	bool bLandPrediction = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	bool bAimSmoothing = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	bool bTurnInPlace = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	bool bDynamicTransitions = true;
+
+	/** Foot IK and land prediction traces run on every Nth anim update */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 1))
+	int32 TraceInterval = 1;
+};
+
+/**
+ * Significance tiers of the anim instance. Pose cache and frozen tiers skip the ALS update entirely, the pose cache
+ * tier plays the baked cycles of the ALS Pose Cache Player node instead of the ALS graph.
+ */
+USTRUCT(BlueprintType)
+struct FALSAnimSignificanceSettings
+{
+	GENERATED_BODY()
+
+	FALSAnimSignificanceSettings()
+	{
+		Reduced.TraceInterval = 2;
+		Reduced.bDynamicTransitions = false;
+
+		Minimal.bFootIKTraces = false;
+		Minimal.bLandPrediction = false;
+		Minimal.bAimSmoothing = false;
+		Minimal.bTurnInPlace = false;
+		Minimal.bDynamicTransitions = false;
+	}
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	bool bEnableSignificanceTiers = false;
+
+	/** Lowest significance of each tier, as returned by the GetAnimSignificance of the character */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0, ClampMax = 1))
+	float MinFullSignificance = 0.7f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0, ClampMax = 1))
+	float MinReducedSignificance = 0.4f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0, ClampMax = 1))
+	float MinMinimalSignificance = 0.1f;
+
+	/** Needs an ALS Pose Cache Player node with a pose cache in the anim graph, characters freeze below it */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	bool bUsePoseCache = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0, ClampMax = 1, EditCondition = "bUsePoseCache"))
+	float MinPoseCacheSignificance = 0.02f;
+
+	/** Seconds between significance updates */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0))
+	float SignificanceUpdateInterval = 0.25f;
+
+	/** Features fade in and out at this rate per second when the tier changes */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0))
+	float TierBlendSpeed = 4.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	FALSAnimTierSettings Full;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	FALSAnimTierSettings Reduced;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	FALSAnimTierSettings Minimal;
+};
+
 USTRUCT(BlueprintType)
 struct FALSAnimTurnInPlace
 {
@@ -388,9 +746,6 @@ struct FALSAnimTurnInPlace
 	UPROPERTY(EditAnywhere, BlueprintReadOnly)
 	float AimYawRateLimit = 50.0f;
 
-	UPROPERTY(EditAnywhere, BlueprintReadOnly)
-	float ElapsedDelayTime = 0.0f;
-
 	UPROPERTY(EditAnywhere, BlueprintReadOnly)
 	float MinAngleDelay = 0.f;
 
@@ -493,4 +848,88 @@ struct FALSAnimConfiguration
 
 	UPROPERTY(EditAnywhere, BlueprintReadOnly)
 	float IK_TraceDistanceBelowFoot = 45.0f;
+
+	/**
+	 * Use async foot IK traces, results of the previous frame are used for foot and pelvis offsets.
+	 * Sync traces are still used after teleports and movement mode changes.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	bool bUseAsyncFootIKTraces = false;
+
+	/** Reuse the last foot IK trace result of a foot while the foot and the surface below it don't move */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	bool bUseFootIKTraceCache = false;
+
+	/** Maximum distance on XY plane a foot can move before its cached trace result is discarded */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (EditCondition = "bUseFootIKTraceCache", ClampMin = 0))
+	float FootIKTraceCacheEpsilon = 0.5f;
+
+	/**
+	 * Predict landing from the ballistic trajectory instead of sweeping the capsule every frame. A single async
+	 * sweep along the trajectory finds the landing surface, it is repeated only when the velocity leaves the
+	 * trajectory or the predicted landing time passes.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	bool bUseAnalyticLandPrediction = false;
+
+	/** Difference of the velocity to the trajectory which requests a new land prediction sweep */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (EditCondition = "bUseAnalyticLandPrediction", ClampMin = 0))
+	float LandPredictionRefreshVelocity = 100.0f;
+
+	/**
+	 * Foot locking, foot offsets and pelvis offset are computed by the ALS Foot IK anim node during evaluation,
+	 * from FootIKNodeInputs. Foot IK values of the anim instance are not updated.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	bool bUseNativeFootIKNode = false;
+
+	/**
+	 * Layering and base pose weights are read by the ALS Layering anim node from the evaluated poses.
+	 * Only the aim offset and hand IK weights of the layer blending values are updated.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	bool bUseNativeLayeringNode = false;
+
+	/** Longest interpolation step, longer updates are split in equal steps to match per frame interpolation */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0.001))
+	float MaxInterpSubstep = 0.0333f;
+
+	/**
+	 * Lead velocity blend, lean amount, smoothed aiming rotation and angle and foot offsets by the time until the
+	 * next anim update while update rate optimization skips frames.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	bool bExtrapolateSkippedFrames = false;
+
+	/** Fraction of the skipped time values are extrapolated by */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (EditCondition = "bExtrapolateSkippedFrames", ClampMin = 0,
+		ClampMax = 1))
+	float ExtrapolationAmount = 0.5f;
+
+	/**
+	 * Recompute layer blending values, stride blend, play rates, velocity blend target, diagonal scale and yaw
+	 * offsets only when the curves and character values they are derived from change.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	bool bUseDirtyTracking = false;
+
+	/** Smallest change of an input which recomputes the values derived from it */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (EditCondition = "bUseDirtyTracking", ClampMin = 0))
+	float DirtyTrackingTolerance = 0.001f;
+};
+
+/** Curves of the character anim instance read by gameplay code, published once per evaluation */
+USTRUCT(BlueprintType)
+struct FALSGameplayCurves
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS|Animation")
+	float YawOffset = 0.0f;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS|Animation")
+	float RotationAmount = 0.0f;
+
+	/** Frame of the evaluation the values come from, readers ticking before the mesh see the previous frame */
+	uint64 Frame = 0;
 };
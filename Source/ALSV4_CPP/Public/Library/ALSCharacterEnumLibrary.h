@@ -172,3 +172,54 @@ enum class EALSSpawnType : uint8
 	Location,
 	Attached
 };
+
+/**
+ * Anim curves read by ALS code. Names must match the curve names on the skeleton.
+ */
+UENUM(BlueprintType)
+enum class EALSAnimCurve : uint8
+{
+	Mask_AimOffset,
+	Mask_LandPrediction,
+	Mask_FootstepSound,
+	BasePose_N,
+	BasePose_CLF,
+	Layering_Legs,
+	Layering_Legs_Add,
+	Layering_Pelvis,
+	Layering_Pelvis_Add,
+	Layering_Spine,
+	Layering_Spine_Add,
+	Layering_Head,
+	Layering_Head_Add,
+	Layering_Arm_L,
+	Layering_Arm_L_Add,
+	Layering_Arm_L_LS,
+	Layering_Arm_R,
+	Layering_Arm_R_Add,
+	Layering_Arm_R_LS,
+	Layering_Hand_L,
+	Layering_Hand_R,
+	Enable_HandIK_L,
+	Enable_HandIK_R,
+	Enable_FootIK_L,
+	Enable_FootIK_R,
+	FootLock_L,
+	FootLock_R,
+	Enable_Transition,
+	W_Gait,
+	YawOffset,
+	RotationAmount,
+	MAX UMETA(Hidden)
+};
+
+/* Anim feature tier of a character, assigned from its significance */
+UENUM(BlueprintType)
+enum class EALSAnimSignificance : uint8
+{
+	Full,
+	Reduced,
+	Minimal,
+	PoseCache,
+	Frozen
+};
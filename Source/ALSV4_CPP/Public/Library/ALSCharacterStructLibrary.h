@@ -307,3 +307,69 @@ struct FALSHitFX : public FTableRowBase
 	UPROPERTY(EditAnywhere, Category = "Niagara")
 	FRotator NiagaraRotationOffset;
 };
+
+/** Character values the anim instance and the camera behavior read, published once per frame by the character */
+USTRUCT(BlueprintType)
+struct FALSCharacterFrameState
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	FVector Acceleration = FVector::ZeroVector;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	float Speed = 0.0f;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	float MovementInputAmount = 0.0f;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	float AimYawRate = 0.0f;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	bool bIsMoving = false;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	bool bHasMovementInput = false;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	bool bRightShoulder = false;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	EALSMovementState MovementState = EALSMovementState::None;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	EALSMovementState PrevMovementState = EALSMovementState::None;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	EALSMovementAction MovementAction = EALSMovementAction::None;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	EALSRotationMode RotationMode = EALSRotationMode::LookingDirection;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	EALSGait Gait = EALSGait::Walking;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	EALSStance Stance = EALSStance::Standing;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	EALSViewMode ViewMode = EALSViewMode::ThirdPerson;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	EALSOverlayState OverlayState = EALSOverlayState::Default;
+};
+
+/** Tick rate of characters down to a given significance */
+USTRUCT(BlueprintType)
+struct FALSTickBucket
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0, ClampMax = 1))
+	float MinSignificance = 0.0f;
+
+	/** Seconds between two ticks of the character and its mantle component, 0 ticks every frame */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 0))
+	float TickInterval = 0.0f;
+};
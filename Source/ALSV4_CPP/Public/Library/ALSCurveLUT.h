@@ -0,0 +1,100 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UCurveBase;
+class UCurveFloat;
+class UCurveVector;
+struct FRichCurve;
+
+/**
+ * Rich curve sampled into a uniform table. Evaluation clamps the time to the key range and lerps two samples,
+ * without searching the keys. Only curves with constant extrapolation and without steps can be baked.
+ */
+struct ALSV4_CPP_API FALSCurveLUT
+{
+	/** Defaults of als.CurveLUT.Resolution and als.CurveLUT.MaxError */
+	static constexpr int32 DefaultResolution = 128;
+
+	static constexpr float DefaultMaxError = 0.01f;
+
+	/** Bake given curve with given number of segments, returns false if the curve can't be represented */
+	bool Bake(const FRichCurve& Curve, int32 Resolution);
+
+	float Eval(float Time) const
+	{
+		const float Position = (FMath::Clamp(Time, MinTime, MaxTime) - MinTime) * InvStep;
+		const int32 Index = FMath::Min(FMath::TruncToInt(Position), LastSegment);
+		return FMath::Lerp(Samples[Index], Samples[Index + 1], Position - Index);
+	}
+
+	/** Largest difference to the source curve, measured between the samples while baking */
+	float GetMaxError() const { return MaxError; }
+
+	int32 GetResolution() const { return LastSegment + 1; }
+
+	/** Shared table of given curve channel, baked on first request. Null if LUTs are disabled or can't be baked. */
+	static TSharedPtr<const FALSCurveLUT> FindOrBake(const UCurveBase* Curve, const FRichCurve& RichCurve,
+	                                                 int32 Channel);
+
+	/** Drop all shared tables, they are baked again on next request */
+	static void ResetShared();
+
+	static bool IsEnabled();
+
+private:
+	float MinTime = 0.0f;
+
+	float MaxTime = 0.0f;
+
+	float InvStep = 0.0f;
+
+	int32 LastSegment = 0;
+
+	float MaxError = 0.0f;
+
+	TArray<float> Samples;
+};
+
+/** UCurveFloat evaluated through a shared LUT when enabled */
+struct ALSV4_CPP_API FALSCurveFloatLUT
+{
+	/** Cheap if the curve and als.CurveLUT.Enable didn't change since the last bind */
+	void Bind(const UCurveFloat* InCurve);
+
+	const UCurveFloat* GetCurve() const { return Curve; }
+
+	float GetValue(float Time) const;
+
+private:
+	const UCurveFloat* Curve = nullptr;
+
+	TSharedPtr<const FALSCurveLUT> LUT;
+
+	bool bLUTEnabled = false;
+};
+
+/** UCurveVector evaluated through shared LUTs when enabled */
+struct ALSV4_CPP_API FALSCurveVectorLUT
+{
+	void Bind(const UCurveVector* InCurve);
+
+	const UCurveVector* GetCurve() const { return Curve; }
+
+	FVector GetValue(float Time) const;
+
+private:
+	const UCurveVector* Curve = nullptr;
+
+	TSharedPtr<const FALSCurveLUT> LUTs[3];
+
+	bool bLUTEnabled = false;
+};
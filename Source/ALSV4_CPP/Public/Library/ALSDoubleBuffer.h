@@ -0,0 +1,60 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Single writer double buffer, read without a lock. The writer fills the back copy and publishes it by bumping the
+ * sequence, readers copy the front one. The write after a publish goes to the copy which was the front before it,
+ * so a reader retries its copy if any publish happened while it copied.
+ */
+template <typename T>
+class TALSDoubleBuffer
+{
+public:
+	/** Copy the writer fills before publishing it. Writer only. */
+	T& GetBack()
+	{
+		return Buffers[(FPlatformAtomics::AtomicRead_Relaxed(&Sequence) + 1) & 1];
+	}
+
+	/** Make the back copy visible to readers. Writer only. */
+	void Publish()
+	{
+		FPlatformAtomics::AtomicStore(&Sequence, FPlatformAtomics::AtomicRead_Relaxed(&Sequence) + 1);
+	}
+
+	void Publish(const T& Value)
+	{
+		GetBack() = Value;
+		Publish();
+	}
+
+	/** Last published copy. Any thread. */
+	T Read() const
+	{
+		while (true)
+		{
+			const int32 ReadSequence = FPlatformAtomics::AtomicRead(&Sequence);
+			T Value = Buffers[ReadSequence & 1];
+			FPlatformMisc::MemoryBarrier();
+			if (FPlatformAtomics::AtomicRead(&Sequence) == ReadSequence)
+			{
+				return Value;
+			}
+		}
+	}
+
+private:
+	T Buffers[2];
+
+	/** Number of publishes, its parity is the front copy */
+	volatile int32 Sequence = 0;
+};
@@ -56,8 +56,28 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "ALS|Math Utils")
 	static bool AngleInRange(float Angle, float MinAngle, float MaxAngle, float Buffer, bool IncreaseBuffer);
 
+	/**
+	 * Interpolation which gives the same result for one long update as for several short ones, e.g. when URO
+	 * skips frames. Delta times longer than MaxStep are split in equal steps.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Math Utils")
+	static float FInterpToSubstepped(float Current, float Target, float DeltaTime, float InterpSpeed,
+	                                 float MaxStep = 0.0333f);
+
+	UFUNCTION(BlueprintCallable, Category = "ALS|Math Utils")
+	static FVector VInterpToSubstepped(const FVector& Current, const FVector& Target, float DeltaTime,
+	                                   float InterpSpeed, float MaxStep = 0.0333f);
+
+	UFUNCTION(BlueprintCallable, Category = "ALS|Math Utils")
+	static FRotator RInterpToSubstepped(const FRotator& Current, const FRotator& Target, float DeltaTime,
+	                                    float InterpSpeed, float MaxStep = 0.0333f);
+
 	UFUNCTION(BlueprintCallable, Category = "ALS|Math Utils")
 	static EALSMovementDirection CalculateQuadrant(EALSMovementDirection Current, float FRThreshold, float FLThreshold,
 	                                               float BRThreshold,
 	                                               float BLThreshold, float Buffer, float Angle);
+
+private:
+	/** Total interpolation alpha of DeltaTime split in steps no longer than MaxStep */
+	static float GetSubsteppedInterpAlpha(float DeltaTime, float InterpSpeed, float MaxStep);
 };
@@ -12,6 +12,10 @@
 
 #include "ALSStructEnumLibrary.generated.h"
 
+/*
+ * Wrappers below keep the enum value and one bit per enum entry, so anim graphs can read each state as a bool
+ * without comparing enums.
+ */
 
 USTRUCT(BlueprintType)
 struct FALSMovementState
@@ -23,32 +27,32 @@ private:
 	EALSMovementState State = EALSMovementState::None;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = true))
-	bool None_ = true;
+	uint8 None_ : 1;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = true))
-	bool Grounded_ = false;
+	uint8 Grounded_ : 1;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = true))
-	bool InAir_ = false;
+	uint8 InAir_ : 1;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = true))
-	bool Mantling_ = false;
+	uint8 Mantling_ : 1;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = true))
-	bool Ragdoll_ = false;
+	uint8 Ragdoll_ : 1;
 
 public:
-	FALSMovementState()
+	FALSMovementState() : FALSMovementState(EALSMovementState::None)
 	{
 	}
 
 	FALSMovementState(const EALSMovementState InitialState) { *this = InitialState; }
 
-	const bool& None() const { return None_; }
-	const bool& Grounded() const { return Grounded_; }
-	const bool& InAir() const { return InAir_; }
-	const bool& Mantling() const { return Mantling_; }
-	const bool& Ragdoll() const { return Ragdoll_; }
+	bool None() const { return None_; }
+	bool Grounded() const { return Grounded_; }
+	bool InAir() const { return InAir_; }
+	bool Mantling() const { return Mantling_; }
+	bool Ragdoll() const { return Ragdoll_; }
 
 	operator EALSMovementState() const { return State; }
 
@@ -73,20 +77,20 @@ private:
 	EALSStance Stance = EALSStance::Standing;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = true))
-	bool Standing_ = true;
+	uint8 Standing_ : 1;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = true))
-	bool Crouching_ = false;
+	uint8 Crouching_ : 1;
 
 public:
-	FALSStance()
+	FALSStance() : FALSStance(EALSStance::Standing)
 	{
 	}
 
 	FALSStance(const EALSStance InitialStance) { *this = InitialStance; }
 
-	const bool& Standing() const { return Standing_; }
-	const bool& Crouching() const { return Crouching_; }
+	bool Standing() const { return Standing_; }
+	bool Crouching() const { return Crouching_; }
 
 	operator EALSStance() const { return Stance; }
 
@@ -108,24 +112,24 @@ private:
 	EALSRotationMode RotationMode = EALSRotationMode::VelocityDirection;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = true))
-	bool VelocityDirection_ = true;
+	uint8 VelocityDirection_ : 1;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = true))
-	bool LookingDirection_ = false;
+	uint8 LookingDirection_ : 1;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = true))
-	bool Aiming_ = false;
+	uint8 Aiming_ : 1;
 
 public:
-	FALSRotationMode()
+	FALSRotationMode() : FALSRotationMode(EALSRotationMode::VelocityDirection)
 	{
 	}
 
 	FALSRotationMode(const EALSRotationMode InitialRotationMode) { *this = InitialRotationMode; }
 
-	const bool& VelocityDirection() const { return VelocityDirection_; }
-	const bool& LookingDirection() const { return LookingDirection_; }
-	const bool& Aiming() const { return Aiming_; }
+	bool VelocityDirection() const { return VelocityDirection_; }
+	bool LookingDirection() const { return LookingDirection_; }
+	bool Aiming() const { return Aiming_; }
 
 	operator EALSRotationMode() const { return RotationMode; }
 
@@ -148,19 +152,19 @@ private:
 	EALSMovementDirection MovementDirection = EALSMovementDirection::Forward;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = true))
-	bool Forward_ = true;
+	uint8 Forward_ : 1;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = true))
-	bool Right_ = false;
+	uint8 Right_ : 1;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = true))
-	bool Left_ = false;
+	uint8 Left_ : 1;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = true))
-	bool Backward_ = false;
+	uint8 Backward_ : 1;
 
 public:
-	FALSMovementDirection()
+	FALSMovementDirection() : FALSMovementDirection(EALSMovementDirection::Forward)
 	{
 	}
 
@@ -169,10 +173,10 @@ public:
 		*this = InitialMovementDirection;
 	}
 
-	const bool& Forward() const { return Forward_; }
-	const bool& Right() const { return Right_; }
-	const bool& Left() const { return Left_; }
-	const bool& Backward() const { return Backward_; }
+	bool Forward() const { return Forward_; }
+	bool Right() const { return Right_; }
+	bool Left() const { return Left_; }
+	bool Backward() const { return Backward_; }
 
 	operator EALSMovementDirection() const { return MovementDirection; }
 
@@ -196,32 +200,32 @@ private:
 	EALSMovementAction Action = EALSMovementAction::None;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = true))
-	bool None_ = true;
+	uint8 None_ : 1;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = true))
-	bool LowMantle_ = false;
+	uint8 LowMantle_ : 1;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = true))
-	bool HighMantle_ = false;
+	uint8 HighMantle_ : 1;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = true))
-	bool Rolling_ = false;
+	uint8 Rolling_ : 1;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = true))
-	bool GettingUp_ = false;
+	uint8 GettingUp_ : 1;
 
 public:
-	FALSMovementAction()
+	FALSMovementAction() : FALSMovementAction(EALSMovementAction::None)
 	{
 	}
 
 	FALSMovementAction(const EALSMovementAction InitialAction) { *this = InitialAction; }
 
-	const bool& None() const { return None_; }
-	const bool& LowMantle() const { return LowMantle_; }
-	const bool& HighMantle() const { return HighMantle_; }
-	const bool& Rolling() const { return Rolling_; }
-	const bool& GettingUp() const { return GettingUp_; }
+	bool None() const { return None_; }
+	bool LowMantle() const { return LowMantle_; }
+	bool HighMantle() const { return HighMantle_; }
+	bool Rolling() const { return Rolling_; }
+	bool GettingUp() const { return GettingUp_; }
 
 	operator EALSMovementAction() const { return Action; }
 
@@ -246,24 +250,24 @@ private:
 	EALSGait Gait = EALSGait::Walking;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = true))
-	bool Walking_ = true;
+	uint8 Walking_ : 1;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = true))
-	bool Running_ = false;
+	uint8 Running_ : 1;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = true))
-	bool Sprinting_ = false;
+	uint8 Sprinting_ : 1;
 
 public:
-	FALSGait()
+	FALSGait() : FALSGait(EALSGait::Walking)
 	{
 	}
 
 	FALSGait(const EALSGait InitialGait) { *this = InitialGait; }
 
-	const bool& Walking() const { return Walking_; }
-	const bool& Running() const { return Running_; }
-	const bool& Sprinting() const { return Sprinting_; }
+	bool Walking() const { return Walking_; }
+	bool Running() const { return Running_; }
+	bool Sprinting() const { return Sprinting_; }
 
 	operator EALSGait() const { return Gait; }
 
@@ -286,64 +290,64 @@ private:
 	EALSOverlayState State = EALSOverlayState::Default;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = true))
-	bool Default_ = true;
+	uint8 Default_ : 1;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = true))
-	bool Masculine_ = false;
+	uint8 Masculine_ : 1;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = true))
-	bool Feminine_ = false;
+	uint8 Feminine_ : 1;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = true))
-	bool Injured_ = false;
+	uint8 Injured_ : 1;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = true))
-	bool HandsTied_ = false;
+	uint8 HandsTied_ : 1;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = true))
-	bool Rifle_ = false;
+	uint8 Rifle_ : 1;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = true))
-	bool PistolOneHanded_ = false;
+	uint8 PistolOneHanded_ : 1;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = true))
-	bool PistolTwoHanded_ = false;
+	uint8 PistolTwoHanded_ : 1;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = true))
-	bool Bow_ = false;
+	uint8 Bow_ : 1;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = true))
-	bool Torch_ = false;
+	uint8 Torch_ : 1;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = true))
-	bool Binoculars_ = false;
+	uint8 Binoculars_ : 1;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = true))
-	bool Box_ = false;
+	uint8 Box_ : 1;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = true))
-	bool Barrel_ = false;
+	uint8 Barrel_ : 1;
 
 public:
-	FALSOverlayState()
+	FALSOverlayState() : FALSOverlayState(EALSOverlayState::Default)
 	{
 	}
 
 	FALSOverlayState(const EALSOverlayState InitialState) { *this = InitialState; }
 
-	const bool& Default() const { return Default_; }
-	const bool& Masculine() const { return Masculine_; }
-	const bool& Feminine() const { return Feminine_; }
-	const bool& Injured() const { return Injured_; }
-	const bool& HandsTied() const { return HandsTied_; }
-	const bool& Rifle() const { return Rifle_; }
-	const bool& PistolOneHanded() const { return PistolOneHanded_; }
-	const bool& PistolTwoHanded() const { return PistolTwoHanded_; }
-	const bool& Bow() const { return Bow_; }
-	const bool& Torch() const { return Torch_; }
-	const bool& Binoculars() const { return Binoculars_; }
-	const bool& Box() const { return Box_; }
-	const bool& Barrel() const { return Barrel_; }
+	bool Default() const { return Default_; }
+	bool Masculine() const { return Masculine_; }
+	bool Feminine() const { return Feminine_; }
+	bool Injured() const { return Injured_; }
+	bool HandsTied() const { return HandsTied_; }
+	bool Rifle() const { return Rifle_; }
+	bool PistolOneHanded() const { return PistolOneHanded_; }
+	bool PistolTwoHanded() const { return PistolTwoHanded_; }
+	bool Bow() const { return Bow_; }
+	bool Torch() const { return Torch_; }
+	bool Binoculars() const { return Binoculars_; }
+	bool Box() const { return Box_; }
+	bool Barrel() const { return Barrel_; }
 
 	operator EALSOverlayState() const { return State; }
 
@@ -376,20 +380,20 @@ private:
 	EALSGroundedEntryState State = EALSGroundedEntryState::None;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = true))
-	bool None_ = true;
+	uint8 None_ : 1;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = true))
-	bool Roll_ = false;
+	uint8 Roll_ : 1;
 
 public:
-	FALSGroundedEntryState()
+	FALSGroundedEntryState() : FALSGroundedEntryState(EALSGroundedEntryState::None)
 	{
 	}
 
 	FALSGroundedEntryState(const EALSGroundedEntryState InitialState) { *this = InitialState; }
 
-	const bool& None() const { return None_; }
-	const bool& Roll() const { return Roll_; }
+	bool None() const { return None_; }
+	bool Roll() const { return Roll_; }
 
 	operator EALSGroundedEntryState() const { return State; }
 
@@ -0,0 +1,21 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:  
+
+using UnrealBuildTool;
+
+public class ALSV4_CPPEditor : ModuleRules
+{
+	public ALSV4_CPPEditor(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(new[]
+			{"Core", "CoreUObject", "Engine", "AnimGraph", "AnimGraphRuntime", "BlueprintGraph", "ALSV4_CPP"});
+
+		PrivateDependencyModuleNames.AddRange(new[] {"UnrealEd", "Slate", "SlateCore"});
+	}
+}
@@ -0,0 +1,29 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "AnimGraph/AnimGraphNode_ALSFootIK.h"
+
+#define LOCTEXT_NAMESPACE "ALSAnimGraphNodes"
+
+FText UAnimGraphNode_ALSFootIK::GetControllerDescription() const
+{
+	return LOCTEXT("ALSFootIK", "ALS Foot IK");
+}
+
+FText UAnimGraphNode_ALSFootIK::GetTooltipText() const
+{
+	return LOCTEXT("ALSFootIK_Tooltip",
+	               "Applies ALS foot locking, foot offsets and pelvis offset to the ik foot bones and the pelvis.");
+}
+
+FText UAnimGraphNode_ALSFootIK::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	return GetControllerDescription();
+}
+
+#undef LOCTEXT_NAMESPACE
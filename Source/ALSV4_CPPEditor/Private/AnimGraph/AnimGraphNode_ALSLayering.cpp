@@ -0,0 +1,34 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "AnimGraph/AnimGraphNode_ALSLayering.h"
+
+#define LOCTEXT_NAMESPACE "ALSAnimGraphNodes"
+
+FText UAnimGraphNode_ALSLayering::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	return LOCTEXT("ALSLayering", "ALS Layering");
+}
+
+FText UAnimGraphNode_ALSLayering::GetTooltipText() const
+{
+	return LOCTEXT("ALSLayering_Tooltip",
+	               "Blends the overlay layer over the base layer per body part using the ALS Layering curves.");
+}
+
+FLinearColor UAnimGraphNode_ALSLayering::GetNodeTitleColor() const
+{
+	return FLinearColor(0.2f, 0.8f, 0.2f);
+}
+
+FString UAnimGraphNode_ALSLayering::GetNodeCategory() const
+{
+	return TEXT("ALS");
+}
+
+#undef LOCTEXT_NAMESPACE
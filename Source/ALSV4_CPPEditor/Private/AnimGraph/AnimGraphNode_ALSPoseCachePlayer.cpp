@@ -0,0 +1,35 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "AnimGraph/AnimGraphNode_ALSPoseCachePlayer.h"
+
+#define LOCTEXT_NAMESPACE "ALSAnimGraphNodes"
+
+FText UAnimGraphNode_ALSPoseCachePlayer::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	return LOCTEXT("ALSPoseCachePlayer", "ALS Pose Cache Player");
+}
+
+FText UAnimGraphNode_ALSPoseCachePlayer::GetTooltipText() const
+{
+	return LOCTEXT("ALSPoseCachePlayer_Tooltip",
+	               "Plays the baked locomotion cycles of an ALS pose cache asset by speed and direction "
+	               "in place of the linked ALS graph while active.");
+}
+
+FLinearColor UAnimGraphNode_ALSPoseCachePlayer::GetNodeTitleColor() const
+{
+	return FLinearColor(0.7f, 0.7f, 0.7f);
+}
+
+FString UAnimGraphNode_ALSPoseCachePlayer::GetNodeCategory() const
+{
+	return TEXT("ALS");
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,34 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Commandlets/ALSAnimReplayCommandlet.h"
+
+#include "ALSV4_CPPEditor.h"
+#include "Character/Animation/ALSAnimRecorder.h"
+
+UALSAnimReplayCommandlet::UALSAnimReplayCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UALSAnimReplayCommandlet::Main(const FString& Params)
+{
+	FString FileName;
+	if (!FParse::Value(*Params, TEXT("Recording="), FileName))
+	{
+		UE_LOG(LogALSEditor, Error, TEXT("Usage: -run=ALSAnimReplay -Recording=<File> [-Iterations=<Count>]"));
+		return 1;
+	}
+
+	int32 Iterations = 1;
+	FParse::Value(*Params, TEXT("Iterations="), Iterations);
+	return FALSAnimRecorder::ReplayFile(FileName, Iterations) ? 0 : 1;
+}
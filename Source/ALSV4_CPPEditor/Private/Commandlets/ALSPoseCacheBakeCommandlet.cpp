@@ -0,0 +1,298 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#include "Commandlets/ALSPoseCacheBakeCommandlet.h"
+
+#include "ALSV4_CPPEditor.h"
+#include "Character/ALSBaseCharacter.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+
+namespace ALSPoseCacheBake
+{
+	/** Distance between two poses, sum of the rotation differences of their bones */
+	float GetPoseError(const FTransform* PoseA, const FTransform* PoseB, int32 NumBones)
+	{
+		float Error = 0.0f;
+		for (int32 Bone = 0; Bone < NumBones; ++Bone)
+		{
+			Error += 1.0f - FMath::Abs(PoseA[Bone].GetRotation() | PoseB[Bone].GetRotation());
+		}
+		return Error;
+	}
+
+	UWorld* CreateWorld()
+	{
+		UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("ALSPoseCacheBake"));
+		FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+		WorldContext.SetCurrentWorld(World);
+		World->InitializeActorsForPlay(FURL());
+		World->BeginPlay();
+
+		// Large enough for the longest capture at sprint speed
+		AStaticMeshActor* Floor = World->SpawnActor<AStaticMeshActor>(FVector(0.0f, 0.0f, -50.0f),
+		                                                               FRotator::ZeroRotator);
+		Floor->GetStaticMeshComponent()->SetMobility(EComponentMobility::Movable);
+		Floor->GetStaticMeshComponent()->SetStaticMesh(
+			LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube")));
+		Floor->SetActorScale3D(FVector(2000.0f, 2000.0f, 1.0f));
+		return World;
+	}
+
+	void DestroyWorld(UWorld* World)
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	}
+}
+
+UALSPoseCacheBakeCommandlet::UALSPoseCacheBakeCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UALSPoseCacheBakeCommandlet::Main(const FString& Params)
+{
+	FString AssetPath;
+	if (!FParse::Value(*Params, TEXT("Asset="), AssetPath))
+	{
+		UE_LOG(LogALSEditor, Error, TEXT("Usage: -run=ALSPoseCacheBake -Asset=/Game/Path/PoseCacheAsset"));
+		return 1;
+	}
+
+	UALSPoseCacheAsset* PoseCache = LoadObject<UALSPoseCacheAsset>(nullptr, *AssetPath);
+	if (!PoseCache || !PoseCache->CharacterClass)
+	{
+		UE_LOG(LogALSEditor, Error, TEXT("%s is not a pose cache asset with a character class"), *AssetPath);
+		return 1;
+	}
+
+	UWorld* World = ALSPoseCacheBake::CreateWorld();
+	TArray<FCapture> Captures;
+	for (const EALSStance Stance : PoseCache->Stances)
+	{
+		for (const EALSOverlayState OverlayState : PoseCache->OverlayStates)
+		{
+			FCapture& Idle = Captures.AddDefaulted_GetRef();
+			if (!Capture(*World, *PoseCache, EALSGait::Walking, Stance, OverlayState, 0.0f, 0.0f, Idle))
+			{
+				Captures.Pop();
+			}
+
+			for (const EALSGait Gait : PoseCache->Gaits)
+			{
+				// Sprint is only allowed towards the aiming direction
+				const int32 NumDirections = Gait == EALSGait::Sprinting ? 1 : PoseCache->NumDirections;
+				for (const float InputAmount : PoseCache->InputAmounts)
+				{
+					for (int32 DirectionIndex = 0; DirectionIndex < NumDirections; ++DirectionIndex)
+					{
+						const float Direction = FRotator::NormalizeAxis(360.0f * DirectionIndex / NumDirections);
+						FCapture& Moving = Captures.AddDefaulted_GetRef();
+						if (!Capture(*World, *PoseCache, Gait, Stance, OverlayState, Direction, InputAmount, Moving))
+						{
+							Captures.Pop();
+						}
+					}
+				}
+			}
+		}
+	}
+	ALSPoseCacheBake::DestroyWorld(World);
+
+	if (Captures.Num() == 0)
+	{
+		UE_LOG(LogALSEditor, Error, TEXT("No cycle could be captured for %s"), *AssetPath);
+		return 1;
+	}
+
+	Compress(*PoseCache, Captures);
+
+	UPackage* Package = PoseCache->GetOutermost();
+	Package->MarkPackageDirty();
+	const FString FileName = FPackageName::LongPackageNameToFilename(Package->GetName(),
+	                                                                FPackageName::GetAssetPackageExtension());
+	if (!UPackage::SavePackage(Package, PoseCache, RF_Standalone, *FileName))
+	{
+		UE_LOG(LogALSEditor, Error, TEXT("Failed to save %s"), *FileName);
+		return 1;
+	}
+
+	UE_LOG(LogALSEditor, Display, TEXT("Baked %d cycles of %d bones into %s"), PoseCache->Cycles.Num(),
+	       PoseCache->BoneNames.Num(), *AssetPath);
+	return 0;
+}
+
+bool UALSPoseCacheBakeCommandlet::Capture(UWorld& World, const UALSPoseCacheAsset& PoseCache, EALSGait Gait,
+                                          EALSStance Stance, EALSOverlayState OverlayState, float Direction,
+                                          float InputAmount, FCapture& OutCapture) const
+{
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	AALSBaseCharacter* Character = World.SpawnActor<AALSBaseCharacter>(
+		PoseCache.CharacterClass, FVector(0.0f, 0.0f, 100.0f), FRotator::ZeroRotator, SpawnParameters);
+	if (!Character)
+	{
+		return false;
+	}
+	if (!Character->GetMesh()->SkeletalMesh)
+	{
+		Character->Destroy();
+		return false;
+	}
+
+	// No controller drives the character, its control rotation stays along X
+	USkeletalMeshComponent* Mesh = Character->GetMesh();
+	Mesh->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+	Mesh->bEnableUpdateRateOptimizations = false;
+	Character->GetCharacterMovement()->bRunPhysicsWithNoController = true;
+	Character->SetDesiredRotationMode(EALSRotationMode::LookingDirection);
+	Character->SetDesiredGait(Gait);
+	Character->SetDesiredStance(Stance);
+	Character->SetOverlayState(OverlayState);
+	if (Stance == EALSStance::Crouching)
+	{
+		Character->Crouch();
+	}
+
+	const FVector InputDirection = FRotator(0.0f, Direction, 0.0f).Vector();
+	const float DeltaTime = 1.0f / PoseCache.SampleRate;
+	auto Step = [&]()
+	{
+		if (InputAmount > 0.0f)
+		{
+			Character->AddMovementInput(InputDirection, InputAmount);
+		}
+		World.Tick(LEVELTICK_All, DeltaTime);
+	};
+
+	for (float Time = 0.0f; Time < PoseCache.WarmupTime; Time += DeltaTime)
+	{
+		Step();
+	}
+
+	// ALS picks the gait from the input amount, states it falls back from are captured by another input amount
+	if (InputAmount > 0.0f && Character->GetGait() != Gait)
+	{
+		Character->Destroy();
+		return false;
+	}
+
+	const int32 NumBones = Mesh->GetBoneSpaceTransforms().Num();
+	const int32 MaxFrames = FMath::CeilToInt(PoseCache.MaxCycleLength * PoseCache.SampleRate) + 1;
+	TArray<FVector> Locations;
+	OutCapture.Transforms.Reset(MaxFrames * NumBones);
+	for (int32 Frame = 0; Frame < MaxFrames; ++Frame)
+	{
+		Step();
+		OutCapture.Transforms.Append(Mesh->GetBoneSpaceTransforms());
+		Locations.Add(Character->GetActorLocation());
+	}
+
+	// The frame closest to the first one within the allowed cycle lengths closes the cycle
+	const int32 MinFrames = FMath::Max(FMath::FloorToInt(PoseCache.MinCycleLength * PoseCache.SampleRate), 1);
+	int32 NumFrames = MaxFrames - 1;
+	float BestError = MAX_flt;
+	for (int32 Frame = MinFrames; Frame < MaxFrames; ++Frame)
+	{
+		const float Error = ALSPoseCacheBake::GetPoseError(&OutCapture.Transforms[0],
+		                                                   &OutCapture.Transforms[Frame * NumBones], NumBones);
+		if (Error < BestError)
+		{
+			BestError = Error;
+			NumFrames = Frame;
+		}
+	}
+
+	OutCapture.Transforms.SetNum(NumFrames * NumBones);
+	OutCapture.Mesh = Mesh->SkeletalMesh;
+
+	FALSPoseCacheCycle& Cycle = OutCapture.Cycle;
+	Cycle.Gait = Character->GetGait();
+	Cycle.Stance = Stance;
+	Cycle.OverlayState = OverlayState;
+	Cycle.Direction = Direction;
+	Cycle.NumFrames = NumFrames;
+	Cycle.Length = NumFrames * DeltaTime;
+	Cycle.Speed = InputAmount > 0.0f ? (Locations[NumFrames] - Locations[0]).Size2D() / Cycle.Length : 0.0f;
+
+	UE_LOG(LogALSEditor, Display, TEXT("Captured %s %s %s, direction %.0f, speed %.0f: %d frames, error %.3f"),
+	       *UEnum::GetValueAsString(Cycle.Gait), *UEnum::GetValueAsString(Stance),
+	       *UEnum::GetValueAsString(OverlayState), Direction, Cycle.Speed, NumFrames, BestError);
+
+	Character->Destroy();
+	return true;
+}
+
+void UALSPoseCacheBakeCommandlet::Compress(UALSPoseCacheAsset& PoseCache, const TArray<FCapture>& Captures)
+{
+	const USkeletalMesh* Mesh = Captures[0].Mesh;
+	const FReferenceSkeleton& RefSkeleton = Mesh->RefSkeleton;
+	const TArray<FTransform>& RefPose = RefSkeleton.GetRefBonePose();
+	const int32 NumBones = RefSkeleton.GetNum();
+
+	PoseCache.Skeleton = Mesh->Skeleton;
+	PoseCache.BoneNames.Reset(NumBones);
+	for (int32 Bone = 0; Bone < NumBones; ++Bone)
+	{
+		PoseCache.BoneNames.Add(RefSkeleton.GetBoneName(Bone));
+	}
+
+	// Only bones which move away from the reference pose keep their translations
+	PoseCache.TranslationTracks.Reset();
+	for (int32 Bone = 0; Bone < NumBones; ++Bone)
+	{
+		bool bAnimated = false;
+		for (int32 Index = 0; Index < Captures.Num() && !bAnimated; ++Index)
+		{
+			const TArray<FTransform>& Transforms = Captures[Index].Transforms;
+			for (int32 Offset = Bone; Offset < Transforms.Num() && !bAnimated; Offset += NumBones)
+			{
+				bAnimated = !Transforms[Offset].GetTranslation().Equals(RefPose[Bone].GetTranslation(),
+				                                                        PoseCache.TranslationTolerance);
+			}
+		}
+
+		if (bAnimated)
+		{
+			PoseCache.TranslationTracks.Add(Bone);
+		}
+	}
+
+	PoseCache.Cycles.Reset(Captures.Num());
+	for (const FCapture& Capture : Captures)
+	{
+		FALSPoseCacheCycle& Cycle = PoseCache.Cycles.Add_GetRef(Capture.Cycle);
+		Cycle.Rotations.SetNumUninitialized(Cycle.NumFrames * NumBones * 3);
+		Cycle.Translations.Reset(Cycle.NumFrames * PoseCache.TranslationTracks.Num());
+		for (int32 Frame = 0; Frame < Cycle.NumFrames; ++Frame)
+		{
+			const FTransform* Pose = &Capture.Transforms[Frame * NumBones];
+			for (int32 Bone = 0; Bone < NumBones; ++Bone)
+			{
+				UALSPoseCacheAsset::QuantizeRotation(Pose[Bone].GetRotation(),
+				                                     &Cycle.Rotations[(Frame * NumBones + Bone) * 3]);
+			}
+
+			for (const int32 Bone : PoseCache.TranslationTracks)
+			{
+				Cycle.Translations.Add(Pose[Bone].GetTranslation());
+			}
+		}
+	}
+}
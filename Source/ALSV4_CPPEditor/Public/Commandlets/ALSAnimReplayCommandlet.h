@@ -0,0 +1,31 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+
+#include "ALSAnimReplayCommandlet.generated.h"
+
+/**
+ * Replays a recording of ALS anim updates, made with als.AnimRecord.Start and als.AnimRecord.Stop, on headless
+ * anim instances. Reports the time per update and fails if any update doesn't reproduce the recorded state.
+ *
+ * Usage: UE4Editor-Cmd <Project> -run=ALSAnimReplay -Recording=<File> [-Iterations=<Count>] -nullrhi
+ */
+UCLASS()
+class ALSV4_CPPEDITOR_API UALSAnimReplayCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UALSAnimReplayCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,51 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "Character/Animation/ALSPoseCacheAsset.h"
+
+#include "ALSPoseCacheBakeCommandlet.generated.h"
+
+class USkeletalMesh;
+
+/**
+ * Bakes an ALS pose cache asset. The character class of the asset is spawned in a transient world and driven
+ * through movement input for each quantized state, the anim instance runs as it does in game. One cycle
+ * of local bone transforms is captured per state.
+ *
+ * Usage: UE4Editor-Cmd <Project> -run=ALSPoseCacheBake -Asset=/Game/Path/PoseCacheAsset
+ */
+UCLASS()
+class ALSV4_CPPEDITOR_API UALSPoseCacheBakeCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UALSPoseCacheBakeCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	struct FCapture
+	{
+		FALSPoseCacheCycle Cycle;
+
+		/** Local transforms of all bones, NumFrames * NumBones */
+		TArray<FTransform> Transforms;
+
+		const USkeletalMesh* Mesh = nullptr;
+	};
+
+	bool Capture(UWorld& World, const UALSPoseCacheAsset& PoseCache, EALSGait Gait, EALSStance Stance,
+	             EALSOverlayState OverlayState, float Direction, float InputAmount, FCapture& OutCapture) const;
+
+	static void Compress(UALSPoseCacheAsset& PoseCache, const TArray<FCapture>& Captures);
+};